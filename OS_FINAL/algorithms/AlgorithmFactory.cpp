@@ -5,6 +5,7 @@
 #include "HamiltonAlgorithm.h"
 #include "SCCAlgorithm.h"
 #include <stdexcept>
+#include <algorithm>
 
 std::unique_ptr<AlgorithmStrategy> AlgorithmFactory::createAlgorithm(AlgorithmType type) {
     switch (type) {
@@ -23,7 +24,41 @@ std::unique_ptr<AlgorithmStrategy> AlgorithmFactory::createAlgorithm(AlgorithmTy
     }
 }
 
-AlgorithmType AlgorithmFactory::stringToType(const std::string& str) {
+std::unique_ptr<AlgorithmStrategy> AlgorithmFactory::createAlgorithm(const std::string& spec) {
+    std::string name, variant;
+    splitSpec(spec, name, variant);
+    AlgorithmType type = stringToType(name);
+    
+    if (variant.empty()) {
+        return createAlgorithm(type);
+    }
+    
+    switch (type) {
+        case AlgorithmType::SCC:
+            if (variant == "tarjan") return std::make_unique<SCCAlgorithm>(SCCAlgorithm::Mode::TARJAN);
+            if (variant == "kosaraju") return std::make_unique<SCCAlgorithm>(SCCAlgorithm::Mode::KOSARAJU);
+            if (variant == "parallel") return std::make_unique<SCCAlgorithm>(SCCAlgorithm::Mode::PARALLEL);
+            break;
+        case AlgorithmType::MST_WEIGHT:
+            if (variant == "auto") return std::make_unique<MSTAlgorithm>(MSTAlgorithm::Mode::AUTO);
+            if (variant == "kruskal") return std::make_unique<MSTAlgorithm>(MSTAlgorithm::Mode::KRUSKAL);
+            if (variant == "prim") return std::make_unique<MSTAlgorithm>(MSTAlgorithm::Mode::PRIM);
+            if (variant == "boruvka") return std::make_unique<MSTAlgorithm>(MSTAlgorithm::Mode::BORUVKA);
+            break;
+        case AlgorithmType::HAMILTON_CIRCUIT:
+            if (variant == "auto") return std::make_unique<HamiltonAlgorithm>(HamiltonAlgorithm::Mode::AUTO);
+            if (variant == "dp") return std::make_unique<HamiltonAlgorithm>(HamiltonAlgorithm::Mode::DP);
+            if (variant == "backtrack") return std::make_unique<HamiltonAlgorithm>(HamiltonAlgorithm::Mode::BACKTRACK);
+            break;
+        default:
+            break;
+    }
+    throw std::invalid_argument("Unknown variant '" + variant + "' for algorithm " + name);
+}
+
+AlgorithmType AlgorithmFactory::stringToType(const std::string& spec) {
+    std::string str, variant;
+    splitSpec(spec, str, variant);
     if (str == "euler") return AlgorithmType::EULER_CIRCUIT;
     if (str == "clique") return AlgorithmType::MAX_CLIQUE;
     if (str == "mst") return AlgorithmType::MST_WEIGHT;
@@ -52,11 +87,35 @@ std::vector<AlgorithmType> AlgorithmFactory::getAllAlgorithmTypes() {
             AlgorithmType::MST_WEIGHT, AlgorithmType::HAMILTON_CIRCUIT, AlgorithmType::SCC};
 }
 
+std::vector<std::string> AlgorithmFactory::getVariantNames(AlgorithmType type) {
+    switch (type) {
+        case AlgorithmType::SCC: return {"tarjan", "kosaraju", "parallel"};
+        case AlgorithmType::MST_WEIGHT: return {"auto", "kruskal", "prim", "boruvka"};
+        case AlgorithmType::HAMILTON_CIRCUIT: return {"auto", "dp", "backtrack"};
+        default: return {};
+    }
+}
+
 bool AlgorithmFactory::isValidAlgorithm(const std::string& name) {
     try {
-        stringToType(name);
-        return true;
+        std::string base, variant;
+        splitSpec(name, base, variant);
+        AlgorithmType type = stringToType(base);
+        if (variant.empty()) return true;
+        auto variants = getVariantNames(type);
+        return std::find(variants.begin(), variants.end(), variant) != variants.end();
     } catch (const std::exception&) {
         return false;
     }
+}
+
+void AlgorithmFactory::splitSpec(const std::string& spec, std::string& name, std::string& variant) {
+    size_t colon = spec.find(':');
+    if (colon == std::string::npos) {
+        name = spec;
+        variant.clear();
+    } else {
+        name = spec.substr(0, colon);
+        variant = spec.substr(colon + 1);
+    }
 }
\ No newline at end of file
@@ -7,14 +7,22 @@
 #include <vector>
 
 // Factory Pattern
+// Algorithms are named by a spec string "name[:variant]", e.g. "scc" or
+// "scc:kosaraju". The variant selects an alternative engine for the same
+// problem; omitting it picks the default.
 class AlgorithmFactory {
 public:
     static std::unique_ptr<AlgorithmStrategy> createAlgorithm(AlgorithmType type);
+    static std::unique_ptr<AlgorithmStrategy> createAlgorithm(const std::string& spec);
     static AlgorithmType stringToType(const std::string& str);
     static std::string typeToString(AlgorithmType type);
     static std::vector<std::string> getAllAlgorithmNames();
     static std::vector<AlgorithmType> getAllAlgorithmTypes();
+    static std::vector<std::string> getVariantNames(AlgorithmType type);
     static bool isValidAlgorithm(const std::string& name);
+
+private:
+    static void splitSpec(const std::string& spec, std::string& name, std::string& variant);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "AlgorithmRunner.h"
+#include "AlgorithmFactory.h"
+#include "HamiltonAlgorithm.h"
+#include "../threading/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+AlgorithmResult AlgorithmRunner::runOne(AlgorithmType type, const Graph& graph) {
+    try {
+        auto algorithm = AlgorithmFactory::createAlgorithm(type);
+        return algorithm->execute(graph);
+    } catch (const std::exception& e) {
+        AlgorithmResult errorResult(type);
+        errorResult.success = false;
+        errorResult.error = e.what();
+        return errorResult;
+    }
+}
+
+std::vector<AlgorithmResult> AlgorithmRunner::runAll(const Graph& undirectedGraph, const Graph& directedGraph,
+                                                     Mode mode, ResultCache* cache, Mask mask) {
+    if (mask == 0) {
+        throw std::invalid_argument("No algorithms selected");
+    }
+    if (mask & ~ALL_ALGORITHMS) {
+        throw std::invalid_argument("Unknown algorithms in mask: " + std::to_string(mask));
+    }
+
+    std::vector<AlgorithmType> types;
+    for (AlgorithmType type : AlgorithmFactory::getAllAlgorithmTypes()) {
+        if (mask & maskOf(type)) {
+            types.push_back(type);
+        }
+    }
+    auto graphFor = [&](AlgorithmType type) -> const Graph& {
+        return type == AlgorithmType::SCC ? directedGraph : undirectedGraph;
+    };
+
+    std::vector<AlgorithmResult> results;
+    for (AlgorithmType type : types) {
+        results.emplace_back(type);
+    }
+
+    // Indices of the algorithms that still have to run
+    std::vector<size_t> pending;
+    ResultCache::GraphKeys undirectedKeys(undirectedGraph);
+    ResultCache::GraphKeys directedKeys(directedGraph);
+    auto keysFor = [&](AlgorithmType type) -> ResultCache::GraphKeys& {
+        return type == AlgorithmType::SCC ? directedKeys : undirectedKeys;
+    };
+    for (size_t i = 0; i < types.size(); ++i) {
+        if (!cache || !cache->lookup(AlgorithmFactory::typeToString(types[i]), keysFor(types[i]), results[i])) {
+            pending.push_back(i);
+        }
+    }
+
+    if (mode == Mode::SERIAL || pending.size() < 2) {
+        for (size_t i : pending) {
+            results[i] = runOne(types[i], graphFor(types[i]));
+        }
+    } else {
+        // Most expensive first: the pool starts tasks in submission order
+        int vertices = undirectedGraph.getVertexCount();
+        int edges = undirectedGraph.getEdgeCount();
+        std::stable_sort(pending.begin(), pending.end(), [&](size_t a, size_t b) {
+            return estimateCost(types[a], vertices, edges) > estimateCost(types[b], vertices, edges);
+        });
+
+        // The graphs are frozen, so the algorithms can share them read-only.
+        // The caller runs the most expensive algorithm itself and helps with
+        // the rest while it waits.
+        TaskGroup group(ThreadPool::shared());
+        for (size_t k = 1; k < pending.size(); ++k) {
+            size_t i = pending[k];
+            group.run([&, i]() { results[i] = runOne(types[i], graphFor(types[i])); });
+        }
+        results[pending[0]] = runOne(types[pending[0]], graphFor(types[pending[0]]));
+        group.wait();
+    }
+
+    if (cache) {
+        for (size_t i : pending) {
+            cache->insert(AlgorithmFactory::typeToString(types[i]), keysFor(types[i]), results[i]);
+        }
+    }
+    return results;
+}
+
+AlgorithmRunner::Mask AlgorithmRunner::maskFromList(const std::string& names) {
+    if (names == "all") {
+        return ALL_ALGORITHMS;
+    }
+    Mask mask = 0;
+    std::istringstream list(names);
+    std::string name;
+    while (std::getline(list, name, ',')) {
+        mask |= maskOf(AlgorithmFactory::stringToType(name));
+    }
+    if (mask == 0) {
+        throw std::invalid_argument("No algorithms selected");
+    }
+    return mask;
+}
+
+double AlgorithmRunner::estimateCost(AlgorithmType type, int vertices, int edges) {
+    double n = vertices > 0 ? vertices : 0;
+    double m = edges > 0 ? edges : 0;
+    switch (type) {
+        case AlgorithmType::EULER_CIRCUIT:
+        case AlgorithmType::SCC:
+            return n + m;
+        case AlgorithmType::MST_WEIGHT:
+            return n + m * std::log2(n + 2);
+        case AlgorithmType::MAX_CLIQUE: {
+            // Branching happens inside neighbourhoods, which have about the
+            // average degree d; at most 3^(d/3) maximal cliques each (Moon-Moser)
+            double degree = n > 1 ? std::min(n - 1, 2 * m / n) : 0;
+            return n * std::pow(3.0, degree / 3) * std::ceil(n / 64 + 1);
+        }
+        case AlgorithmType::HAMILTON_CIRCUIT: {
+            // Budgeted backtracking (never more than (n-1)! paths), then the
+            // Held-Karp DP when the budget runs out and the graph is small enough
+            double budget = HamiltonAlgorithm::HEURISTIC_NODE_BUDGET;
+            double paths = 1;
+            for (int k = 2; k < vertices && paths < budget; ++k) {
+                paths *= k;
+            }
+            double cost = n * std::min(paths, budget);
+            if (paths >= budget && vertices <= HamiltonAlgorithm::DP_MAX_VERTICES) {
+                cost += n * std::ldexp(1.0, vertices);
+            }
+            return cost;
+        }
+    }
+    return n + m;
+}
+
+double AlgorithmRunner::estimateCost(Mask mask, int vertices, int edges) {
+    double cost = 0;
+    for (AlgorithmType type : AlgorithmFactory::getAllAlgorithmTypes()) {
+        if (mask & maskOf(type)) {
+            cost += estimateCost(type, vertices, edges);
+        }
+    }
+    return cost;
+}
+
+std::string AlgorithmRunner::modeToString(Mode mode) {
+    return mode == Mode::FAN_OUT ? "fanout" : "serial";
+}
+
+AlgorithmRunner::Mode AlgorithmRunner::stringToMode(const std::string& name) {
+    if (name == "serial") return Mode::SERIAL;
+    if (name == "fanout") return Mode::FAN_OUT;
+    throw std::invalid_argument("Unknown algorithm mode: " + name + " (expected serial or fanout)");
+}
@@ -0,0 +1,53 @@
+#ifndef ALGORITHM_RUNNER_H
+#define ALGORITHM_RUNNER_H
+
+#include "AlgorithmStrategy.h"
+#include "ResultCache.h"
+#include <vector>
+#include <cstdint>
+
+// Runs every algorithm on one request's graphs, as the multi-algorithm
+// servers do: SCC on the directed graph, the rest on the undirected one.
+// An algorithm that throws yields an error result instead, so one failure
+// never hides the others. Results come back in getAllAlgorithmTypes() order.
+// With a cache, algorithms already run on an identical graph are answered
+// from it and only the misses execute.
+// A mask restricts the run to some algorithms: bit i selects AlgorithmType i.
+// When they run concurrently, the ones estimated to be most expensive start
+// first, so the slowest algorithm is not left to start last.
+class AlgorithmRunner {
+public:
+    typedef uint32_t Mask;
+
+    enum class Mode {
+        SERIAL,     // one after another on the calling thread
+        FAN_OUT     // concurrently on ThreadPool::shared(); latency ~ slowest algorithm
+    };
+
+    static const Mask ALL_ALGORITHMS = 0x1f;
+
+    // Throws std::invalid_argument for an empty mask or unknown bits
+    static std::vector<AlgorithmResult> runAll(const Graph& undirectedGraph, const Graph& directedGraph,
+                                               Mode mode = Mode::SERIAL, ResultCache* cache = nullptr,
+                                               Mask mask = ALL_ALGORITHMS);
+
+    static Mask maskOf(AlgorithmType type) { return Mask(1) << static_cast<int>(type); }
+
+    // "mst,scc" style list of AlgorithmFactory names, or "all". Throws
+    // std::invalid_argument for an unknown name or an empty list.
+    static Mask maskFromList(const std::string& names);
+
+    // Rough number of elementary steps one algorithm takes on a graph of this
+    // size, for scheduling decisions - not a promise. The exponential searches
+    // (clique, hamilton) are charged their worst case for the graph's density.
+    static double estimateCost(AlgorithmType type, int vertices, int edges);
+    static double estimateCost(Mask mask, int vertices, int edges);
+
+    static std::string modeToString(Mode mode);
+    static Mode stringToMode(const std::string& name);
+
+private:
+    static AlgorithmResult runOne(AlgorithmType type, const Graph& graph);
+};
+
+#endif
@@ -19,8 +19,10 @@ struct AlgorithmResult {
     std::string error;
     std::string executionTime;
     AlgorithmType type;
+    bool labelInvariant;        // names no vertices, so it holds for every relabelling of the graph
+    bool vertexSets;            // names vertices only inside "{a,b,...}" sets, which can be relabelled
     
-    AlgorithmResult(AlgorithmType t) : success(false), type(t) {}
+    AlgorithmResult(AlgorithmType t) : success(false), type(t), labelInvariant(false), vertexSets(false) {}
 };
 
 // Strategy Pattern - base interface
@@ -1,4 +1,5 @@
 #include "EulerAlgorithm.h"
+#include "../common/EulerEngine.h"
 #include <sstream>
 #include <chrono>
 
@@ -6,11 +7,12 @@ AlgorithmResult EulerAlgorithm::execute(const Graph& graph) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
-        Graph workingGraph = graph;
+        // Runs on the caller's graph directly - no working copy needed
+        auto circuit = EulerEngine(graph).findCircuit();
         
-        if (!workingGraph.hasEulerCircuit()) {
+        if (circuit.empty()) {
             std::string reason;
-            if (!workingGraph.isConnected()) {
+            if (!graph.isConnected()) {
                 reason = "graph not connected";
             } else if (!graph.isDirected()) {
                 reason = "not all vertices have even degree";
@@ -24,11 +26,10 @@ AlgorithmResult EulerAlgorithm::execute(const Graph& graph) {
             AlgorithmResult result = createResult(AlgorithmType::EULER_CIRCUIT, 
                 "No Euler circuit (" + reason + ")");
             result.executionTime = std::to_string(duration.count()) + "μs";
+            result.labelInvariant = true;
             return result;
         }
         
-        auto circuit = workingGraph.findEulerCircuit();
-        
         std::ostringstream ss;
         ss << "Euler circuit: ";
         for (size_t i = 0; i < circuit.size(); ++i) {
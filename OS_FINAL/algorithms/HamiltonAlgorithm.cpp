@@ -9,23 +9,42 @@ AlgorithmResult HamiltonAlgorithm::execute(const Graph& graph) {
     try {
         int n = graph.getVertexCount();
         
-        if (n > 12) {
+        int maxVertices = (mode == Mode::BACKTRACK) ? BACKTRACK_MAX_VERTICES
+                        : (mode == Mode::DP) ? DP_MAX_VERTICES : HEURISTIC_MAX_VERTICES;
+        if (n > maxVertices) {
             return createError(AlgorithmType::HAMILTON_CIRCUIT, 
-                "Graph too large for exact algorithm (max 12 vertices)");
+                "Graph too large for exact algorithm (max " + std::to_string(maxVertices) + " vertices)");
         }
         
         if (n < 3) {
-            return createResult(AlgorithmType::HAMILTON_CIRCUIT, 
+            AlgorithmResult result = createResult(AlgorithmType::HAMILTON_CIRCUIT, 
                 "Hamilton circuit requires at least 3 vertices");
+            result.labelInvariant = true;
+            return result;
         }
         
         std::vector<int> path(n + 1, -1);
-        std::vector<bool> visited(n, false);
+        bool found = false;
+        
+        if (mode != Mode::DP) {
+            std::vector<bool> visited(n, false);
+            path[0] = 0;
+            visited[0] = true;
+            nodeBudget = (mode == Mode::AUTO) ? HEURISTIC_NODE_BUDGET : -1;
+            budgetExhausted = false;
+            found = hamiltonUtil(graph, path, visited, 1);
+        }
         
-        path[0] = 0;
-        visited[0] = true;
+        if (!found && (mode == Mode::DP || budgetExhausted)) {
+            if (n > DP_MAX_VERTICES) {
+                return createError(AlgorithmType::HAMILTON_CIRCUIT, 
+                    "Search budget exhausted; graph too large for exact algorithm (max " +
+                    std::to_string(DP_MAX_VERTICES) + " vertices)");
+            }
+            found = heldKarp(graph, path);
+        }
         
-        if (hamiltonUtil(graph, path, visited, 1)) {
+        if (found) {
             path[n] = path[0]; // Complete the circuit
             
             std::ostringstream ss;
@@ -48,6 +67,7 @@ AlgorithmResult HamiltonAlgorithm::execute(const Graph& graph) {
             AlgorithmResult result = createResult(AlgorithmType::HAMILTON_CIRCUIT, 
                 "No Hamilton circuit exists");
             result.executionTime = std::to_string(duration.count()) + "μs";
+            result.labelInvariant = true;
             return result;
         }
         
@@ -60,15 +80,20 @@ bool HamiltonAlgorithm::hamiltonUtil(const Graph& graph, std::vector<int>& path,
                                     std::vector<bool>& visited, int pos) {
     int n = graph.getVertexCount();
     
+    if (nodeBudget == 0) {
+        budgetExhausted = true;
+        return false;
+    }
+    if (nodeBudget > 0) --nodeBudget;
+    
     if (pos == n) {
         // Check if there's an edge from last vertex back to first
-        auto lastVertexNeighbors = graph.getNeighbors(path[pos - 1]);
-        return std::find(lastVertexNeighbors.begin(), lastVertexNeighbors.end(), path[0]) 
-               != lastVertexNeighbors.end();
+        return graph.hasEdge(path[pos - 1], path[0]);
     }
     
-    for (int v = 1; v < n; ++v) {
-        if (isSafe(graph, v, path, pos) && !visited[v]) {
+    // Only successors of the last vertex can extend the path
+    for (int v : graph.neighbors(path[pos - 1])) {
+        if (!visited[v]) {
             path[pos] = v;
             visited[v] = true;
             
@@ -78,14 +103,62 @@ bool HamiltonAlgorithm::hamiltonUtil(const Graph& graph, std::vector<int>& path,
             
             path[pos] = -1;
             visited[v] = false;
+            
+            if (budgetExhausted) return false;
         }
     }
     
     return false;
 }
 
-bool HamiltonAlgorithm::isSafe(const Graph& graph, int v, 
-                              const std::vector<int>& path, int pos) {
-    auto neighbors = graph.getNeighbors(path[pos - 1]);
-    return std::find(neighbors.begin(), neighbors.end(), v) != neighbors.end();
-}
\ No newline at end of file
+// Held-Karp over subsets of {1..n-1} with vertex 0 as the fixed start.
+// reach[S] is a bitmask of the vertices v in S such that some path starting
+// at 0 visits exactly {0} + S and ends at v, so one 32-bit word holds every
+// DP cell of a subset. Vertex i (i >= 1) is bit i-1.
+bool HamiltonAlgorithm::heldKarp(const Graph& graph, std::vector<int>& path) {
+    int n = graph.getVertexCount();
+    int m = n - 1;
+    uint32_t full = (1u << m) - 1;
+    
+    std::vector<uint32_t> predecessors(m, 0);   // bit u-1 set if u -> v
+    uint32_t fromStart = 0;                     // bit v-1 set if 0 -> v
+    uint32_t toStart = 0;                       // bit u-1 set if u -> 0
+    for (int u = 0; u < n; ++u) {
+        for (int v : graph.neighbors(u)) {
+            if (u == 0) fromStart |= 1u << (v - 1);
+            else if (v == 0) toStart |= 1u << (u - 1);
+            else predecessors[v - 1] |= 1u << (u - 1);
+        }
+    }
+    
+    std::vector<uint32_t> reach(static_cast<size_t>(full) + 1, 0);
+    for (uint32_t S = 1; S <= full; ++S) {
+        if ((S & (S - 1)) == 0) {
+            reach[S] = S & fromStart;
+            continue;
+        }
+        
+        // Branch-free over the members of S: v is an end of S iff some end
+        // of S\{v} has an edge into v
+        uint32_t ends = 0;
+        for (uint32_t bits = S; bits; bits &= bits - 1) {
+            int v = __builtin_ctz(bits);
+            ends |= static_cast<uint32_t>((reach[S ^ (1u << v)] & predecessors[v]) != 0) << v;
+        }
+        reach[S] = ends;
+    }
+    
+    uint32_t closing = reach[full] & toStart;
+    if (closing == 0) return false;
+    
+    // Walk back from an end that can close the circuit
+    uint32_t S = full;
+    int v = __builtin_ctz(closing);
+    path[0] = 0;
+    for (int pos = n - 1; pos >= 1; --pos) {
+        path[pos] = v + 1;
+        S ^= 1u << v;
+        if (S) v = __builtin_ctz(reach[S] & predecessors[v]);
+    }
+    return true;
+}
@@ -2,9 +2,23 @@
 #define HAMILTON_ALGORITHM_H
 
 #include "AlgorithmStrategy.h"
+#include <cstdint>
 
 class HamiltonAlgorithm : public AlgorithmStrategy {
 public:
+    // AUTO: budgeted backtracking first (cheap when a cycle is easy to find),
+    //       then Held-Karp DP when the budget runs out.
+    // DP: Held-Karp bitmask DP only.
+    // BACKTRACK: exhaustive backtracking only.
+    enum class Mode { AUTO, DP, BACKTRACK };
+
+    static const int DP_MAX_VERTICES = 25;          // 2^24 x 32-bit masks = 64MB
+    static const int BACKTRACK_MAX_VERTICES = 12;
+    static const int HEURISTIC_MAX_VERTICES = 100;
+    static const int HEURISTIC_NODE_BUDGET = 200000;
+
+    explicit HamiltonAlgorithm(Mode mode = Mode::AUTO) : mode(mode), nodeBudget(-1), budgetExhausted(false) {}
+
     AlgorithmResult execute(const Graph& graph) override;
     std::string getAlgorithmName() const override { return "Hamilton Circuit"; }
     std::string getDescription() const override { 
@@ -12,11 +26,16 @@ public:
     }
     bool supportsDirected() const override { return true; }
     bool supportsUndirected() const override { return true; }
+    Mode getMode() const { return mode; }
 
 private:
+    Mode mode;
+    int nodeBudget;         // remaining backtracking expansions, -1 = unlimited
+    bool budgetExhausted;
+
     bool hamiltonUtil(const Graph& graph, std::vector<int>& path, 
                      std::vector<bool>& visited, int pos);
-    bool isSafe(const Graph& graph, int v, const std::vector<int>& path, int pos);
+    bool heldKarp(const Graph& graph, std::vector<int>& path);
 };
 
 #endif
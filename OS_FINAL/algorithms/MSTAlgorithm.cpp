@@ -1,8 +1,10 @@
 #include "MSTAlgorithm.h"
+#include "../threading/ThreadPool.h"
 #include <algorithm>
-#include <random>
 #include <sstream>
 #include <chrono>
+#include <atomic>
+#include <thread>
 
 AlgorithmResult MSTAlgorithm::execute(const Graph& graph) {
     auto start = std::chrono::high_resolution_clock::now();
@@ -10,47 +12,26 @@ AlgorithmResult MSTAlgorithm::execute(const Graph& graph) {
     try {
         validateGraph(graph, false, true);
         
+        // Weights and edge counts only: every answer is label-invariant
         if (graph.getEdgeCount() == 0) {
-            return createResult(AlgorithmType::MST_WEIGHT, "MST weight: 0 (no edges)");
+            AlgorithmResult result = createResult(AlgorithmType::MST_WEIGHT, "MST weight: 0 (no edges)");
+            result.labelInvariant = true;
+            return result;
         }
         
         if (!graph.isConnected()) {
-            return createResult(AlgorithmType::MST_WEIGHT, "No MST (graph not connected)");
+            AlgorithmResult result = createResult(AlgorithmType::MST_WEIGHT, "No MST (graph not connected)");
+            result.labelInvariant = true;
+            return result;
         }
         
-        // Generate random weights for edges
-        std::vector<Edge> edges;
-        std::mt19937 gen(42); // Fixed seed for reproducibility
-        std::uniform_int_distribution<> weightDist(1, 10);
-        
-        auto allEdges = graph.getAllEdges();
-        for (const auto& edge : allEdges) {
-            edges.emplace_back(edge.first, edge.second, weightDist(gen));
-        }
-        
-        // Kruskal's algorithm
-        std::sort(edges.begin(), edges.end());
-        
         int n = graph.getVertexCount();
-        std::vector<int> parent(n);
-        std::vector<int> rank(n, 0);
-        for (int i = 0; i < n; ++i) parent[i] = i;
+        bool usePrim = (mode == Mode::PRIM) ||
+                       (mode == Mode::AUTO && 2LL * graph.getEdgeCount() >= 1LL * PRIM_MIN_AVERAGE_DEGREE * n);
         
-        int mstWeight = 0;
         int edgesUsed = 0;
-        
-        for (const auto& edge : edges) {
-            int rootU = find(parent, edge.u);
-            int rootV = find(parent, edge.v);
-            
-            if (rootU != rootV) {
-                mstWeight += edge.weight;
-                unite(parent, rank, rootU, rootV);
-                edgesUsed++;
-                
-                if (edgesUsed == n - 1) break;
-            }
-        }
+        long long mstWeight = (mode == Mode::BORUVKA) ? boruvka(graph, edgesUsed)
+                            : usePrim ? prim(graph, edgesUsed) : kruskal(graph, edgesUsed);
         
         auto end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -60,6 +41,7 @@ AlgorithmResult MSTAlgorithm::execute(const Graph& graph) {
         
         AlgorithmResult result = createResult(AlgorithmType::MST_WEIGHT, ss.str());
         result.executionTime = std::to_string(duration.count()) + "μs";
+        result.labelInvariant = true;
         return result;
         
     } catch (const std::exception& e) {
@@ -67,11 +49,347 @@ AlgorithmResult MSTAlgorithm::execute(const Graph& graph) {
     }
 }
 
+std::vector<MSTAlgorithm::Edge> MSTAlgorithm::collectEdges(const Graph& graph) {
+    std::vector<Edge> edges;
+    edges.reserve(graph.getEdgeCount());
+    for (int u = 0; u < graph.getVertexCount(); ++u) {
+        NeighborRange neighbors = graph.neighbors(u);
+        WeightRange weights = graph.neighborWeights(u);
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            if (u < neighbors[i]) {
+                edges.emplace_back(u, neighbors[i], weights[i]);
+            }
+        }
+    }
+    return edges;
+}
+
+long long MSTAlgorithm::kruskal(const Graph& graph, int& edgesUsed) {
+    int n = graph.getVertexCount();
+    
+    std::vector<Edge> edges = collectEdges(graph);
+    radixSortByWeight(edges);
+    
+    std::vector<int> parent(n);
+    std::vector<int> rank(n, 0);
+    for (int i = 0; i < n; ++i) parent[i] = i;
+    
+    long long mstWeight = 0;
+    edgesUsed = 0;
+    
+    for (const auto& edge : edges) {
+        int rootU = find(parent, edge.u);
+        int rootV = find(parent, edge.v);
+        
+        if (rootU != rootV) {
+            mstWeight += edge.weight;
+            unite(parent, rank, rootU, rootV);
+            edgesUsed++;
+            
+            if (edgesUsed == n - 1) break;
+        }
+    }
+    
+    return mstWeight;
+}
+
+// LSD radix sort on the weight, 8 bits per pass. The sign bit is flipped so
+// negative weights order correctly as unsigned keys; passes where every key
+// has the same digit (common for small weights) are skipped.
+void MSTAlgorithm::radixSortByWeight(std::vector<Edge>& edges) {
+    if (edges.size() < 2) return;
+    
+    std::vector<Edge> buffer(edges);
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t count[257] = {0};
+        for (const auto& edge : edges) {
+            uint32_t key = static_cast<uint32_t>(edge.weight) ^ 0x80000000u;
+            count[((key >> shift) & 0xFF) + 1]++;
+        }
+        
+        bool skip = false;
+        for (int d = 1; d <= 256 && !skip; ++d) skip = (count[d] == edges.size());
+        if (skip) continue;
+        
+        for (int d = 0; d < 256; ++d) count[d + 1] += count[d];
+        for (const auto& edge : edges) {
+            uint32_t key = static_cast<uint32_t>(edge.weight) ^ 0x80000000u;
+            buffer[count[(key >> shift) & 0xFF]++] = edge;
+        }
+        edges.swap(buffer);
+    }
+}
+
+// Indexed d-ary min-heap over vertices keyed by their cheapest connecting
+// edge. A wider node makes decrease-key (the common operation on dense
+// graphs) shallower at the cost of more comparisons per pop.
+class DaryHeap {
+public:
+    DaryHeap(int n, int arity) : d(arity), position(n, -1) { heap.reserve(n); }
+    
+    bool empty() const { return heap.empty(); }
+    bool contains(int v) const { return position[v] >= 0; }
+    
+    void pushOrDecrease(int v, int key) {
+        if (position[v] < 0) {
+            position[v] = static_cast<int>(heap.size());
+            heap.push_back({key, v});
+        } else if (key < heap[position[v]].key) {
+            heap[position[v]].key = key;
+        } else {
+            return;
+        }
+        siftUp(position[v]);
+    }
+    
+    int popMin(int& key) {
+        Entry top = heap[0];
+        position[top.vertex] = -2;      // settled, never re-inserted
+        Entry last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            position[last.vertex] = 0;
+            siftDown(0);
+        }
+        key = top.key;
+        return top.vertex;
+    }
+    
+    bool settled(int v) const { return position[v] == -2; }
+    
+private:
+    struct Entry {
+        int key;
+        int vertex;
+    };
+    
+    int d;
+    std::vector<Entry> heap;
+    std::vector<int> position;     // -1 = never seen, -2 = popped
+    
+    void place(int i, const Entry& entry) {
+        heap[i] = entry;
+        position[entry.vertex] = i;
+    }
+    
+    void siftUp(int i) {
+        Entry entry = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / d;
+            if (heap[parent].key <= entry.key) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, entry);
+    }
+    
+    void siftDown(int i) {
+        Entry entry = heap[i];
+        int size = static_cast<int>(heap.size());
+        while (true) {
+            int first = i * d + 1;
+            if (first >= size) break;
+            int last = std::min(first + d, size);
+            int best = first;
+            for (int c = first + 1; c < last; ++c) {
+                if (heap[c].key < heap[best].key) best = c;
+            }
+            if (heap[best].key >= entry.key) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, entry);
+    }
+};
+
+long long MSTAlgorithm::prim(const Graph& graph, int& edgesUsed) {
+    int n = graph.getVertexCount();
+    int arity = std::max(2, std::min(16, graph.getEdgeCount() / std::max(1, n)));
+    DaryHeap heap(n, arity);
+    
+    long long mstWeight = 0;
+    edgesUsed = 0;
+    
+    // The caller guarantees the graph is connected; start at any vertex with edges
+    int start = 0;
+    while (start < n && graph.getDegree(start) == 0) ++start;
+    if (start == n) return 0;
+    
+    heap.pushOrDecrease(start, 0);
+    bool first = true;
+    while (!heap.empty()) {
+        int key;
+        int u = heap.popMin(key);
+        if (!first) {
+            mstWeight += key;
+            edgesUsed++;
+        }
+        first = false;
+        
+        NeighborRange neighbors = graph.neighbors(u);
+        WeightRange weights = graph.neighborWeights(u);
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            int v = neighbors[i];
+            if (!heap.settled(v)) {
+                heap.pushOrDecrease(v, weights[i]);
+            }
+        }
+    }
+    
+    return mstWeight;
+}
+
+// Lock-free union-find: parents are atomics, find() does path halving with
+// CAS (a lost race only skips a shortcut), and unite() links the larger root
+// under the smaller one with a CAS that fails if either root changed.
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(int n) : parent(n) {
+        for (int i = 0; i < n; ++i) parent[i].store(i, std::memory_order_relaxed);
+    }
+    
+    int find(int v) {
+        while (true) {
+            int p = parent[v].load(std::memory_order_acquire);
+            if (p == v) return v;
+            int grandparent = parent[p].load(std::memory_order_acquire);
+            if (grandparent != p) {
+                parent[v].compare_exchange_weak(p, grandparent, std::memory_order_release,
+                                                std::memory_order_relaxed);
+            }
+            v = grandparent;
+        }
+    }
+    
+    bool unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) std::swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+    
+private:
+    std::vector<std::atomic<int>> parent;
+};
+
+// Parallel Boruvka. Each round:
+//  1. every thread scans a slice of the live edges and records, per
+//     component root, the cheapest outgoing edge with an atomic min over
+//     (weight, edge index) - the index breaks ties so no cycle can form;
+//  2. every root's chosen edge is united concurrently; a union that finds
+//     both ends already joined was picked from both sides and counts once;
+//  3. edges inside a component are filtered out of the live list.
+// The number of components at least halves per round.
+long long MSTAlgorithm::boruvka(const Graph& graph, int& edgesUsed) {
+    int n = graph.getVertexCount();
+    int workers = threadCount > 0 ? threadCount
+                                  : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    
+    std::vector<Edge> edges = collectEdges(graph);
+    std::vector<uint32_t> live(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) live[i] = static_cast<uint32_t>(i);
+    
+    ConcurrentUnionFind components(n);
+    std::vector<std::atomic<uint64_t>> cheapest(n);
+    for (auto& c : cheapest) c.store(UINT64_MAX, std::memory_order_relaxed);
+    std::atomic<long long> totalWeight{0};
+    std::atomic<int> totalEdges{0};
+    
+    // Slice t of [0, count) always goes to body(..., t), so per-slice output
+    // keeps the edge order; the slices run as tasks on the shared pool.
+    ThreadPool& pool = ThreadPool::shared();
+    auto parallelFor = [workers, &pool](size_t count, const auto& body) {
+        size_t chunk = (count + workers - 1) / workers;
+        if (chunk == 0) return;
+        size_t slices = (count + chunk - 1) / chunk;
+        pool.parallelFor(0, slices, [&](size_t first, size_t last) {
+            for (size_t t = first; t < last; ++t) {
+                body(t * chunk, std::min(count, (t + 1) * chunk), static_cast<int>(t));
+            }
+        });
+    };
+    
+    std::vector<std::vector<uint32_t>> kept(workers);
+    while (!live.empty()) {
+        // Step 1: cheapest outgoing edge per component
+        parallelFor(live.size(), [&](size_t begin, size_t end, int) {
+            for (size_t i = begin; i < end; ++i) {
+                const Edge& edge = edges[live[i]];
+                int ru = components.find(edge.u);
+                int rv = components.find(edge.v);
+                if (ru == rv) continue;
+                uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(edge.weight) ^ 0x80000000u) << 32) | live[i];
+                for (int root : {ru, rv}) {
+                    uint64_t current = cheapest[root].load(std::memory_order_relaxed);
+                    while (key < current &&
+                           !cheapest[root].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+                    }
+                }
+            }
+        });
+        
+        // Step 2: hook components along their chosen edges
+        std::atomic<bool> merged{false};
+        parallelFor(n, [&](size_t begin, size_t end, int) {
+            long long weight = 0;
+            int used = 0;
+            for (size_t v = begin; v < end; ++v) {
+                uint64_t key = cheapest[v].exchange(UINT64_MAX, std::memory_order_relaxed);
+                if (key == UINT64_MAX) continue;
+                const Edge& edge = edges[static_cast<uint32_t>(key)];
+                if (components.unite(edge.u, edge.v)) {
+                    weight += edge.weight;
+                    used++;
+                }
+            }
+            if (used > 0) {
+                totalWeight += weight;
+                totalEdges += used;
+                merged.store(true, std::memory_order_relaxed);
+            }
+        });
+        if (!merged.load()) break;
+        
+        // Step 3: drop edges that now lie inside a component
+        parallelFor(live.size(), [&](size_t begin, size_t end, int t) {
+            kept[t].clear();
+            for (size_t i = begin; i < end; ++i) {
+                const Edge& edge = edges[live[i]];
+                if (components.find(edge.u) != components.find(edge.v)) kept[t].push_back(live[i]);
+            }
+        });
+        size_t total = 0;
+        for (int t = 0; t < workers; ++t) {
+            std::copy(kept[t].begin(), kept[t].end(), live.begin() + total);
+            total += kept[t].size();
+            kept[t].clear();
+        }
+        live.resize(total);
+    }
+    
+    edgesUsed = totalEdges.load();
+    return totalWeight.load();
+}
+
 int MSTAlgorithm::find(std::vector<int>& parent, int i) {
-    if (parent[i] != i) {
-        parent[i] = find(parent, parent[i]);
+    // Iterative two-pass path compression (no recursion on long chains)
+    int root = i;
+    while (parent[root] != root) {
+        root = parent[root];
+    }
+    while (parent[i] != root) {
+        int next = parent[i];
+        parent[i] = root;
+        i = next;
     }
-    return parent[i];
+    return root;
 }
 
 void MSTAlgorithm::unite(std::vector<int>& parent, std::vector<int>& rank, int x, int y) {
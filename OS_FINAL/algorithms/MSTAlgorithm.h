@@ -2,16 +2,37 @@
 #define MST_ALGORITHM_H
 
 #include "AlgorithmStrategy.h"
+#include <cstdint>
 
 class MSTAlgorithm : public AlgorithmStrategy {
 public:
+    // AUTO: Kruskal for sparse graphs, Prim for dense ones (by average degree).
+    // KRUSKAL: LSD radix sort of edge weights + union-find.
+    // PRIM: indexed d-ary heap with decrease-key.
+    // BORUVKA: parallel Boruvka rounds over a lock-free union-find.
+    enum class Mode { AUTO, KRUSKAL, PRIM, BORUVKA };
+
+    // AUTO switches to Prim once the average degree reaches this value
+    static const int PRIM_MIN_AVERAGE_DEGREE = 32;
+
+    // threads is only used by BORUVKA; 0 means one per hardware thread.
+    // The work runs on ThreadPool::shared(), so threads bounds how finely it
+    // is split, never how many threads exist.
+    explicit MSTAlgorithm(Mode mode = Mode::AUTO, int threads = 0) : mode(mode), threadCount(threads) {}
+
     AlgorithmResult execute(const Graph& graph) override;
     std::string getAlgorithmName() const override { return "MST Weight"; }
     std::string getDescription() const override { 
-        return "Finds Minimum Spanning Tree weight using Kruskal's algorithm"; 
+        switch (mode) {
+            case Mode::KRUSKAL: return "Finds Minimum Spanning Tree weight using Kruskal's algorithm (radix sort)";
+            case Mode::PRIM: return "Finds Minimum Spanning Tree weight using Prim's algorithm (d-ary heap)";
+            case Mode::BORUVKA: return "Finds Minimum Spanning Tree weight using parallel Boruvka";
+            default: return "Finds Minimum Spanning Tree weight (Kruskal or Prim, chosen by density)";
+        }
     }
     bool supportsDirected() const override { return false; }
     bool supportsUndirected() const override { return true; }
+    Mode getMode() const { return mode; }
 
 private:
     struct Edge {
@@ -20,6 +41,14 @@ private:
         bool operator<(const Edge& other) const { return weight < other.weight; }
     };
     
+    Mode mode;
+    int threadCount;
+
+    std::vector<Edge> collectEdges(const Graph& graph);
+    long long kruskal(const Graph& graph, int& edgesUsed);
+    long long prim(const Graph& graph, int& edgesUsed);
+    long long boruvka(const Graph& graph, int& edgesUsed);
+    void radixSortByWeight(std::vector<Edge>& edges);
     int find(std::vector<int>& parent, int i);
     void unite(std::vector<int>& parent, std::vector<int>& rank, int x, int y);
 };
@@ -9,20 +9,23 @@ AlgorithmResult MaxCliqueAlgorithm::execute(const Graph& graph) {
     try {
         validateGraph(graph, false, true);
         
-        if (graph.getVertexCount() > 15) {
+        if (graph.getVertexCount() > MAX_VERTICES) {
             return createError(AlgorithmType::MAX_CLIQUE, 
-                "Graph too large for exact algorithm (max 15 vertices)");
+                "Graph too large for exact algorithm (max " + std::to_string(MAX_VERTICES) + " vertices)");
         }
         
-        std::vector<int> maxClique;
-        std::vector<int> current;
-        std::vector<int> candidates;
+        buildBitsets(graph);
+        current.clear();
+        maxClique.clear();
         
+        Bitset candidates(words, 0);
         for (int i = 0; i < graph.getVertexCount(); ++i) {
-            candidates.push_back(i);
+            candidates[i / 64] |= 1ULL << (i % 64);
         }
+        expand(candidates);
         
-        findMaxClique(graph, current, candidates, maxClique, 0);
+        for (int& v : maxClique) v = order[v];
+        std::sort(maxClique.begin(), maxClique.end());
         
         std::ostringstream ss;
         ss << "Max clique size: " << maxClique.size();
@@ -39,6 +42,7 @@ AlgorithmResult MaxCliqueAlgorithm::execute(const Graph& graph) {
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
         
         AlgorithmResult result = createResult(AlgorithmType::MAX_CLIQUE, ss.str());
+        result.vertexSets = true;
         result.executionTime = std::to_string(duration.count()) + "μs";
         return result;
         
@@ -47,31 +51,94 @@ AlgorithmResult MaxCliqueAlgorithm::execute(const Graph& graph) {
     }
 }
 
-void MaxCliqueAlgorithm::findMaxClique(const Graph& graph, std::vector<int>& current,
-                                      std::vector<int>& candidates, std::vector<int>& maxClique, int start) {
-    if (current.size() > maxClique.size()) {
-        maxClique = current;
+void MaxCliqueAlgorithm::buildBitsets(const Graph& graph) {
+    int n = graph.getVertexCount();
+    words = (n + 63) / 64;
+    
+    // High-degree vertices first: they get the low bits, so the greedy
+    // coloring handles them first and the bound tightens early.
+    order.resize(n);
+    for (int i = 0; i < n; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return graph.getDegree(a) > graph.getDegree(b);
+    });
+    
+    std::vector<int> position(n);
+    for (int i = 0; i < n; ++i) position[order[i]] = i;
+    
+    adjacency.assign(n, Bitset(words, 0));
+    for (int i = 0; i < n; ++i) {
+        for (int neighbor : graph.neighbors(order[i])) {
+            int j = position[neighbor];
+            adjacency[i][j / 64] |= 1ULL << (j % 64);
+        }
     }
+}
+
+// Greedy sequential coloring of the candidate set: each color class is an
+// independent set, so a vertex with color k can extend the clique by at most
+// k vertices. Vertices come out in non-decreasing color order.
+void MaxCliqueAlgorithm::colorSort(const Bitset& candidates, std::vector<int>& vertices,
+                                   std::vector<int>& colors) const {
+    Bitset uncolored = candidates;
+    Bitset available(words);
+    int color = 0;
     
-    for (int i = start; i < (int)candidates.size(); ++i) {
-        int vertex = candidates[i];
-        current.push_back(vertex);
+    bool remaining = true;
+    while (remaining) {
+        ++color;
+        available = uncolored;
         
-        if (areAllConnected(graph, current)) {
-            findMaxClique(graph, current, candidates, maxClique, i + 1);
+        for (int w = 0; w < words; ++w) {
+            while (available[w]) {
+                int v = w * 64 + __builtin_ctzll(available[w]);
+                available[w] &= available[w] - 1;
+                uncolored[w] &= ~(1ULL << (v % 64));
+                vertices.push_back(v);
+                colors.push_back(color);
+                
+                // Neighbors of v cannot share its color
+                const Bitset& row = adjacency[v];
+                for (int k = w; k < words; ++k) available[k] &= ~row[k];
+            }
         }
         
-        current.pop_back();
+        remaining = false;
+        for (int w = 0; w < words && !remaining; ++w) remaining = uncolored[w] != 0;
     }
 }
 
-bool MaxCliqueAlgorithm::areAllConnected(const Graph& graph, const std::vector<int>& vertices) {
-    for (size_t i = 0; i < vertices.size(); ++i) {
-        for (size_t j = i + 1; j < vertices.size(); ++j) {
-            if (!graph.hasEdge(vertices[i], vertices[j])) {
-                return false;
-            }
+void MaxCliqueAlgorithm::expand(Bitset& candidates) {
+    // Cheap popcount bound before paying for the coloring
+    size_t available = 0;
+    for (int w = 0; w < words; ++w) available += __builtin_popcountll(candidates[w]);
+    if (current.size() + available <= maxClique.size()) return;
+    
+    std::vector<int> vertices, colors;
+    colorSort(candidates, vertices, colors);
+    
+    Bitset next(words);
+    for (int i = static_cast<int>(vertices.size()) - 1; i >= 0; --i) {
+        // Bound: even coloring says this branch cannot beat the incumbent
+        if (current.size() + colors[i] <= maxClique.size()) return;
+        
+        int v = vertices[i];
+        current.push_back(v);
+        
+        bool empty = true;
+        const Bitset& row = adjacency[v];
+        for (int w = 0; w < words; ++w) {
+            next[w] = candidates[w] & row[w];
+            empty = empty && next[w] == 0;
         }
+        
+        if (empty) {
+            if (current.size() > maxClique.size()) maxClique = current;
+        } else {
+            expand(next);
+        }
+        
+        current.pop_back();
+        candidates[v / 64] &= ~(1ULL << (v % 64));
     }
-    return true;
-}
\ No newline at end of file
+}
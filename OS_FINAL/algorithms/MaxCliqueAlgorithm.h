@@ -2,9 +2,15 @@
 #define MAX_CLIQUE_ALGORITHM_H
 
 #include "AlgorithmStrategy.h"
+#include <cstdint>
 
+// Exact maximum clique via branch and bound over bitsets (Tomita's MCQ with
+// San Segundo's bit-parallel greedy coloring). Candidate sets are rows of
+// 64-bit words, so intersections and bounds are word-wide AND/popcount.
 class MaxCliqueAlgorithm : public AlgorithmStrategy {
 public:
+    static const int MAX_VERTICES = 1000;
+
     AlgorithmResult execute(const Graph& graph) override;
     std::string getAlgorithmName() const override { return "Maximum Clique"; }
     std::string getDescription() const override { 
@@ -14,9 +20,17 @@ public:
     bool supportsUndirected() const override { return true; }
 
 private:
-    void findMaxClique(const Graph& graph, std::vector<int>& current, 
-                      std::vector<int>& candidates, std::vector<int>& maxClique, int start);
-    bool areAllConnected(const Graph& graph, const std::vector<int>& vertices);
+    typedef std::vector<uint64_t> Bitset;
+
+    int words;
+    std::vector<Bitset> adjacency;     // adjacency rows in search order
+    std::vector<int> order;            // search position -> graph vertex
+    std::vector<int> current;
+    std::vector<int> maxClique;
+
+    void buildBitsets(const Graph& graph);
+    void expand(Bitset& candidates);
+    void colorSort(const Bitset& candidates, std::vector<int>& vertices, std::vector<int>& colors) const;
 };
 
 #endif
\ No newline at end of file
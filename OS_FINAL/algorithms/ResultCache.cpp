@@ -0,0 +1,260 @@
+#include "ResultCache.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+
+ResultCache::ResultCache(size_t byteBudget, size_t shardCount) : byteBudget(byteBudget) {
+    if (shardCount == 0) {
+        throw std::invalid_argument("Result cache needs at least one shard");
+    }
+    shardBudget = byteBudget / shardCount;
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+ResultCache::Key ResultCache::makeKey(const std::string& algorithm, const GraphSignature& graph) {
+    Key key;
+    key.bytes.reserve(algorithm.size() + 1 + graph.canonical.size());
+    key.bytes.append(algorithm);
+    key.bytes.push_back('\0');
+    key.bytes.append(graph.canonical);
+    key.hash = hashBytes(algorithm, graph.hash);
+    return key;
+}
+
+const GraphSignature& ResultCache::GraphKeys::exact() {
+    if (!exactDone) {
+        exactSignature = GraphSignature::of(graph);
+        exactDone = true;
+    }
+    return exactSignature;
+}
+
+uint64_t ResultCache::GraphKeys::fingerprint() {
+    if (!fingerprintDone) {
+        fingerprintValue = GraphSignature::fingerprint(graph);
+        fingerprintDone = true;
+    }
+    return fingerprintValue;
+}
+
+const GraphSignature* ResultCache::GraphKeys::canonical() {
+    if (!canonicalDone) {
+        hasCanonical = GraphSignature::canonicalOf(graph, canonicalSignature);
+        canonicalDone = true;
+    }
+    return hasCanonical ? &canonicalSignature : nullptr;
+}
+
+uint64_t ResultCache::screenKey(const std::string& algorithm, GraphKeys& graph) {
+    return hashBytes(algorithm, graph.fingerprint());
+}
+
+std::string ResultCache::relabelVertexSets(const std::string& text, const std::vector<int>& labels) {
+    std::string out;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t open = text.find('{', pos);
+        size_t close = open == std::string::npos ? open : text.find('}', open);
+        if (close == std::string::npos) {
+            break;
+        }
+        out.append(text, pos, open + 1 - pos);
+
+        std::vector<int> members;
+        std::istringstream in(text.substr(open + 1, close - open - 1));
+        std::string vertex;
+        while (std::getline(in, vertex, ',')) {
+            members.push_back(labels.at(std::stoi(vertex)));
+        }
+        std::sort(members.begin(), members.end());
+        for (size_t i = 0; i < members.size(); ++i) {
+            if (i > 0) out.push_back(',');
+            out.append(std::to_string(members[i]));
+        }
+        out.push_back('}');
+        pos = close + 1;
+    }
+    out.append(text, pos, std::string::npos);
+    return out;
+}
+
+bool ResultCache::mayHaveCanonical(uint64_t screen) const {
+    std::shared_lock<std::shared_mutex> lock(screenMutex);
+    return canonicalScreen.count(screen) != 0;
+}
+
+bool ResultCache::lookup(const std::string& algorithm, GraphKeys& graph, AlgorithmResult& result) {
+    Key key = makeKey(algorithm, graph.exact());
+    Shard& shard = shardFor(key);
+
+    bool hit = find(key, result);
+    // The fingerprint rules out most graphs without canonicalizing them
+    if (!hit && mayHaveCanonical(screenKey(algorithm, graph))) {
+        const GraphSignature* canonical = graph.canonical();
+        if (canonical && find(makeKey(algorithm, *canonical), result)) {
+            hit = true;
+            shard.isomorphicHits.fetch_add(1, std::memory_order_relaxed);
+            if (result.vertexSets) {
+                // Stored in canonical labels; name this graph's vertices again
+                std::vector<int> vertexAt(canonical->labels.size());
+                for (size_t v = 0; v < canonical->labels.size(); ++v) {
+                    vertexAt[canonical->labels[v]] = static_cast<int>(v);
+                }
+                result.result = relabelVertexSets(result.result, vertexAt);
+            }
+            // Repeats of this labelling can skip canonicalization from now on
+            store(std::move(key), result);
+        }
+    }
+
+    // Counted on the exact key's shard, once per lookup
+    (hit ? shard.hits : shard.misses).fetch_add(1, std::memory_order_relaxed);
+    if (hit) {
+        result.executionTime = "cached";
+    }
+    return hit;
+}
+
+void ResultCache::insert(const std::string& algorithm, GraphKeys& graph, const AlgorithmResult& result) {
+    store(makeKey(algorithm, graph.exact()), result);
+    if (!result.labelInvariant && !result.vertexSets) {
+        return;
+    }
+    const GraphSignature* canonical = graph.canonical();
+    if (!canonical) {
+        return;
+    }
+    if (result.vertexSets) {
+        AlgorithmResult relabelled = result;
+        relabelled.result = relabelVertexSets(result.result, canonical->labels);
+        store(makeKey(algorithm, *canonical), relabelled, true, screenKey(algorithm, graph));
+    } else {
+        store(makeKey(algorithm, *canonical), result, true, screenKey(algorithm, graph));
+    }
+}
+
+bool ResultCache::find(const Key& key, AlgorithmResult& result) {
+    Shard& shard = shardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        return false;
+    }
+    Entry& entry = *shard.ring[it->second];
+    entry.referenced.store(true, std::memory_order_relaxed);
+    result = entry.result;
+    return true;
+}
+
+void ResultCache::store(Key key, const AlgorithmResult& result, bool canonical, uint64_t screen) {
+    size_t bytes = ENTRY_OVERHEAD + key.bytes.size() + result.result.size() + result.error.size() +
+                   result.executionTime.size();
+    if (bytes > shardBudget) {
+        return;
+    }
+
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.index.count(key) != 0) {
+        // Another thread computed the same result first
+        return;
+    }
+    while (shard.bytes + bytes > shardBudget && !shard.ring.empty()) {
+        evictOne(shard);
+    }
+
+    auto inserted = shard.index.emplace(std::move(key), shard.ring.size());
+    shard.ring.push_back(std::make_unique<Entry>(&inserted.first->first, result, bytes, canonical, screen));
+    shard.bytes += bytes;
+    shard.insertions.fetch_add(1, std::memory_order_relaxed);
+
+    if (canonical) {
+        std::unique_lock<std::shared_mutex> screenLock(screenMutex);
+        canonicalScreen[screen]++;
+    }
+}
+
+void ResultCache::releaseScreen(uint64_t screen) {
+    std::unique_lock<std::shared_mutex> lock(screenMutex);
+    // clear() may already have dropped it
+    auto it = canonicalScreen.find(screen);
+    if (it != canonicalScreen.end() && --it->second == 0) {
+        canonicalScreen.erase(it);
+    }
+}
+
+void ResultCache::evictOne(Shard& shard) {
+    // Sweep the hand, giving every referenced entry a second chance
+    for (;;) {
+        if (shard.hand >= shard.ring.size()) {
+            shard.hand = 0;
+        }
+        Entry& entry = *shard.ring[shard.hand];
+        if (!entry.referenced.exchange(false, std::memory_order_relaxed)) {
+            break;
+        }
+        shard.hand++;
+    }
+
+    size_t victim = shard.hand;
+    shard.bytes -= shard.ring[victim]->bytes;
+    if (shard.ring[victim]->canonical) {
+        releaseScreen(shard.ring[victim]->screen);
+    }
+    shard.index.erase(shard.index.find(*shard.ring[victim]->key));
+
+    // Fill the hole with the last entry; the hand examines it next
+    if (victim != shard.ring.size() - 1) {
+        shard.ring[victim] = std::move(shard.ring.back());
+        shard.index.find(*shard.ring[victim]->key)->second = victim;
+    }
+    shard.ring.pop_back();
+    shard.evictions.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ResultCache::clear() {
+    for (auto& shard : shards) {
+        std::unique_lock<std::shared_mutex> lock(shard->mutex);
+        shard->ring.clear();
+        shard->index.clear();
+        shard->hand = 0;
+        shard->bytes = 0;
+    }
+    std::unique_lock<std::shared_mutex> lock(screenMutex);
+    canonicalScreen.clear();
+}
+
+ResultCacheStats ResultCache::getStats() const {
+    ResultCacheStats stats = {0, 0, 0, 0, 0, 0, 0, byteBudget};
+    for (const auto& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        stats.hits += shard->hits.load(std::memory_order_relaxed);
+        stats.isomorphicHits += shard->isomorphicHits.load(std::memory_order_relaxed);
+        stats.misses += shard->misses.load(std::memory_order_relaxed);
+        stats.insertions += shard->insertions.load(std::memory_order_relaxed);
+        stats.evictions += shard->evictions.load(std::memory_order_relaxed);
+        stats.entries += shard->ring.size();
+        stats.bytes += shard->bytes;
+    }
+    return stats;
+}
+
+std::string ResultCache::formatStats() const {
+    ResultCacheStats stats = getStats();
+    unsigned long long lookups = stats.hits + stats.misses;
+
+    std::ostringstream out;
+    out << "Result cache: " << stats.hits << " hits (" << stats.isomorphicHits << " isomorphic), "
+        << stats.misses << " misses";
+    if (lookups > 0) {
+        out << " (" << std::fixed << std::setprecision(1) << 100.0 * stats.hits / lookups << "% hit rate)";
+    }
+    out << "\n";
+    out << "Result cache size: " << stats.entries << " entries, " << stats.bytes << "/" << stats.byteBudget
+        << " bytes, " << stats.evictions << " evictions\n";
+    return out.str();
+}
@@ -0,0 +1,151 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "AlgorithmStrategy.h"
+#include "../common/GraphSignature.h"
+#include <unordered_map>
+#include <shared_mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+
+// Snapshot of a ResultCache's counters, summed over all shards
+struct ResultCacheStats {
+    unsigned long long hits;
+    unsigned long long isomorphicHits;  // hits answered from a relabelled copy of the graph
+    unsigned long long misses;
+    unsigned long long insertions;
+    unsigned long long evictions;
+    size_t entries;
+    size_t bytes;               // approximate memory held by the entries
+    size_t byteBudget;
+};
+
+// Content-addressed cache of algorithm results, keyed by the algorithm spec
+// and the GraphSignature of the graph it ran on. Every result is stored under
+// the graph's exact signature. Label-invariant results (see AlgorithmResult)
+// are also stored under its canonical signature, and so are vertex-set results
+// after renaming their vertices to canonical labels, so isomorphic requests
+// with relabelled vertices share them. A graph is only canonicalized on an
+// exact miss when some canonical entry of the algorithm shares its
+// Weisfeiler-Lehman fingerprint.
+// The key space is split over independently locked shards. Lookups take a
+// shard's lock shared and only set a reference bit, so concurrent hits never
+// serialize; evictions follow the CLOCK policy within each shard, keeping the
+// shard under its share of the byte budget.
+class ResultCache {
+public:
+    static const size_t DEFAULT_BYTE_BUDGET = 16 << 20;
+    static const size_t DEFAULT_SHARD_COUNT = 16;
+
+    // The signatures of one graph, computed on first use and shared by every
+    // lookup and insert for it. The fingerprint and canonical one are only
+    // attempted once the exact signature missed.
+    class GraphKeys {
+    public:
+        explicit GraphKeys(const Graph& graph) : graph(graph), exactDone(false), fingerprintDone(false),
+                                                 canonicalDone(false), hasCanonical(false), fingerprintValue(0) {}
+
+        const GraphSignature& exact();
+        uint64_t fingerprint();
+        const GraphSignature* canonical();      // null if the graph cannot be canonicalized
+
+    private:
+        const Graph& graph;
+        bool exactDone;
+        bool fingerprintDone;
+        bool canonicalDone;
+        bool hasCanonical;
+        uint64_t fingerprintValue;
+        GraphSignature exactSignature;
+        GraphSignature canonicalSignature;
+    };
+
+    explicit ResultCache(size_t byteBudget = DEFAULT_BYTE_BUDGET, size_t shardCount = DEFAULT_SHARD_COUNT);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Tries the exact signature, then the canonical one. On a hit copies the
+    // stored result into 'result' (its executionTime reads "cached").
+    bool lookup(const std::string& algorithm, GraphKeys& graph, AlgorithmResult& result);
+
+    // Results larger than a shard's budget are not stored
+    void insert(const std::string& algorithm, GraphKeys& graph, const AlgorithmResult& result);
+
+    void clear();
+
+    ResultCacheStats getStats() const;
+
+    // Two "key: value" lines for the servers' stats replies
+    std::string formatStats() const;
+
+private:
+    // Rough per-entry bookkeeping cost (entry, index node, ring slot)
+    static const size_t ENTRY_OVERHEAD = 160;
+
+    struct Key {
+        std::string bytes;      // algorithm spec, '\0', canonical graph
+        uint64_t hash;
+
+        bool operator==(const Key& other) const { return hash == other.hash && bytes == other.bytes; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+    };
+
+    struct Entry {
+        const Key* key;         // points into the shard's index
+        AlgorithmResult result;
+        size_t bytes;
+        bool canonical;         // stored under a canonical signature
+        uint64_t screen;        // screenKey of a canonical entry
+        std::atomic<bool> referenced;
+
+        Entry(const Key* key, const AlgorithmResult& result, size_t bytes, bool canonical, uint64_t screen)
+            : key(key), result(result), bytes(bytes), canonical(canonical), screen(screen), referenced(false) {}
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, size_t, KeyHash> index;     // key -> ring slot
+        std::vector<std::unique_ptr<Entry>> ring;
+        size_t hand = 0;
+        size_t bytes = 0;
+
+        std::atomic<unsigned long long> hits{0};
+        std::atomic<unsigned long long> isomorphicHits{0};
+        std::atomic<unsigned long long> misses{0};
+        std::atomic<unsigned long long> insertions{0};
+        std::atomic<unsigned long long> evictions{0};
+    };
+
+    size_t byteBudget;
+    size_t shardBudget;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // Canonical entries per (algorithm, fingerprint). Taken after a shard's
+    // lock, never before one.
+    mutable std::shared_mutex screenMutex;
+    std::unordered_map<uint64_t, size_t> canonicalScreen;
+
+    static Key makeKey(const std::string& algorithm, const GraphSignature& graph);
+    static uint64_t screenKey(const std::string& algorithm, GraphKeys& graph);
+    Shard& shardFor(const Key& key) const { return *shards[(key.hash >> 32) % shards.size()]; }
+
+    // Renames the vertices in every "{a,b,...}" set through 'labels' and
+    // sorts each set
+    static std::string relabelVertexSets(const std::string& text, const std::vector<int>& labels);
+
+    bool mayHaveCanonical(uint64_t screen) const;
+    bool find(const Key& key, AlgorithmResult& result);
+    void store(Key key, const AlgorithmResult& result, bool canonical = false, uint64_t screen = 0);
+
+    // Caller holds the shard's lock exclusively
+    void evictOne(Shard& shard);
+    void releaseScreen(uint64_t screen);
+};
+
+#endif
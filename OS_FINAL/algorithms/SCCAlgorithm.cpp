@@ -1,42 +1,105 @@
 #include "SCCAlgorithm.h"
+#include "../common/GraphTraversal.h"
+#include "../threading/ThreadPool.h"
 #include <algorithm>
 #include <sstream>
 #include <chrono>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 
-AlgorithmResult SCCAlgorithm::execute(const Graph& graph) {
-    auto start = std::chrono::high_resolution_clock::now();
+// Below this many vertices a parallel subproblem is finished with Tarjan
+// instead of being split further by forward-backward reachability.
+static const size_t PARALLEL_SEQUENTIAL_CUTOFF = 512;
+// Subproblems at least this large run their backward search on a helper thread.
+static const size_t PARALLEL_SPLIT_REACH_CUTOFF = 4096;
+
+// Pearce's single-pass variant of Tarjan: rindex[] doubles as DFS index and
+// low-link, and finished vertices are relabelled with their component number
+// (counting down from the scope size), so no separate on-stack flag is needed.
+// Only neighbors accepted by inScope are followed, which lets the parallel
+// engine run it on one subproblem while other threads own the rest.
+template <typename InScope>
+static void pearceSCC(const Graph& graph, const std::vector<int>& roots, InScope inScope,
+                      std::vector<int>& rindex, std::vector<std::vector<int>>& sccs) {
+    struct Frame {
+        int vertex;
+        int next;
+        bool root;
+    };
     
-    try {
-        validateGraph(graph, true, false);
+    std::vector<int> pending;
+    std::vector<Frame> callStack;
+    callStack.reserve(roots.size());
+    pending.reserve(roots.size());
+    
+    int index = 1;
+    int component = static_cast<int>(roots.size()) - 1;
+    
+    for (int s : roots) {
+        if (rindex[s] != 0) continue;
         
-        int n = graph.getVertexCount();
-        std::vector<bool> visited(n, false);
-        std::stack<int> finishOrder;
+        rindex[s] = index++;
+        callStack.push_back({s, 0, true});
         
-        // Step 1: DFS on original graph to get finish order
-        for (int i = 0; i < n; ++i) {
-            if (!visited[i]) {
-                dfs1(graph, i, visited, finishOrder);
+        while (!callStack.empty()) {
+            Frame& frame = callStack.back();
+            int v = frame.vertex;
+            NeighborRange neighbors = graph.neighbors(v);
+            
+            if (frame.next < static_cast<int>(neighbors.size())) {
+                int w = neighbors[frame.next++];
+                if (!inScope(w)) continue;
+                if (rindex[w] == 0) {
+                    rindex[w] = index++;
+                    callStack.push_back({w, 0, true});
+                } else if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    frame.root = false;
+                }
+                continue;
             }
-        }
-        
-        // Step 2: Create transpose graph
-        Graph transposed = transposeGraph(graph);
-        
-        // Step 3: DFS on transpose graph in reverse finish order
-        std::fill(visited.begin(), visited.end(), false);
-        std::vector<std::vector<int>> sccs;
-        
-        while (!finishOrder.empty()) {
-            int v = finishOrder.top();
-            finishOrder.pop();
             
-            if (!visited[v]) {
-                std::vector<int> component;
-                dfs2(transposed, v, visited, component);
-                sccs.push_back(component);
+            // All successors explored: close v
+            bool root = frame.root;
+            callStack.pop_back();
+            
+            if (root) {
+                std::vector<int> members{v};
+                --index;
+                while (!pending.empty() && rindex[v] <= rindex[pending.back()]) {
+                    int w = pending.back();
+                    pending.pop_back();
+                    rindex[w] = component;
+                    members.push_back(w);
+                    --index;
+                }
+                rindex[v] = component--;
+                sccs.push_back(std::move(members));
+            } else {
+                pending.push_back(v);
+            }
+            
+            // Propagate low-link to the parent frame
+            if (!callStack.empty()) {
+                Frame& parent = callStack.back();
+                if (rindex[v] < rindex[parent.vertex]) {
+                    rindex[parent.vertex] = rindex[v];
+                    parent.root = false;
+                }
             }
         }
+    }
+}
+
+AlgorithmResult SCCAlgorithm::execute(const Graph& graph) {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    try {
+        validateGraph(graph, true, false);
+        
+        std::vector<std::vector<int>> sccs = findComponents(graph);
         
         // Format result
         std::ostringstream ss;
@@ -55,6 +118,7 @@ AlgorithmResult SCCAlgorithm::execute(const Graph& graph) {
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
         
         AlgorithmResult result = createResult(AlgorithmType::SCC, ss.str());
+        result.vertexSets = true;
         result.executionTime = std::to_string(duration.count()) + "μs";
         return result;
         
@@ -63,31 +127,247 @@ AlgorithmResult SCCAlgorithm::execute(const Graph& graph) {
     }
 }
 
-void SCCAlgorithm::dfs1(const Graph& graph, int v, std::vector<bool>& visited, 
-                       std::stack<int>& finishOrder) {
-    visited[v] = true;
-    
-    auto neighbors = graph.getNeighbors(v);
-    for (int neighbor : neighbors) {
-        if (!visited[neighbor]) {
-            dfs1(graph, neighbor, visited, finishOrder);
+std::vector<std::vector<int>> SCCAlgorithm::findComponents(const Graph& graph) {
+    switch (mode) {
+        case Mode::KOSARAJU: return kosaraju(graph);
+        case Mode::PARALLEL: return parallel(graph);
+        default: return tarjan(graph);
+    }
+}
+
+std::vector<std::vector<int>> SCCAlgorithm::tarjan(const Graph& graph) {
+    int n = graph.getVertexCount();
+    std::vector<int> roots(n);
+    for (int i = 0; i < n; ++i) roots[i] = i;
+    
+    std::vector<int> rindex(n, 0);
+    std::vector<std::vector<int>> sccs;
+    pearceSCC(graph, roots, [](int) { return true; }, rindex, sccs);
+    return sccs;
+}
+
+std::vector<std::vector<int>> SCCAlgorithm::kosaraju(const Graph& graph) {
+    int n = graph.getVertexCount();
+    std::vector<bool> visited(n, false);
+    std::stack<int> finishOrder;
+    
+    // Step 1: DFS on original graph to get finish order
+    GraphTraversal forward(graph);
+    for (int i = 0; i < n; ++i) {
+        forward.dfs(i, visited, [](int) {}, [&](int v) { finishOrder.push(v); });
+    }
+    
+    // Step 2: Create transpose graph
+    Graph transposed = transposeGraph(graph);
+    
+    // Step 3: DFS on transpose graph in reverse finish order
+    std::fill(visited.begin(), visited.end(), false);
+    std::vector<std::vector<int>> sccs;
+    GraphTraversal backward(transposed);
+    
+    while (!finishOrder.empty()) {
+        int v = finishOrder.top();
+        finishOrder.pop();
+        
+        if (!visited[v]) {
+            std::vector<int> component;
+            backward.dfs(v, visited, [&](int u) { component.push_back(u); }, [](int) {});
+            sccs.push_back(component);
         }
     }
     
-    finishOrder.push(v);
+    return sccs;
 }
 
-void SCCAlgorithm::dfs2(const Graph& transposeGraph, int v, std::vector<bool>& visited, 
-                       std::vector<int>& component) {
-    visited[v] = true;
-    component.push_back(v);
-    
-    auto neighbors = transposeGraph.getNeighbors(v);
-    for (int neighbor : neighbors) {
-        if (!visited[neighbor]) {
-            dfs2(transposeGraph, neighbor, visited, component);
+// Forward-backward decomposition with trimming:
+//  1. Trim: vertices with no in- or out-edges left are singleton SCCs.
+//  2. For each remaining subproblem (vertices sharing a color), the SCC of a
+//     pivot is FW(pivot) ∩ BW(pivot). FW\BW, BW\FW and the rest cannot share
+//     an SCC, so they become independent subproblems, forked as tasks on the
+//     shared thread pool.
+// At most threadCount searches run at once: a subproblem is forked only while
+// a slot is free, otherwise the task that split it keeps it.
+// Tasks only read or write colors/marks of vertices in their own subproblem.
+// They may read another vertex's color, which is atomic and never matches
+// since every new color is fresh, and touch its marks only once it matches.
+std::vector<std::vector<int>> SCCAlgorithm::parallel(const Graph& graph) {
+    struct Task {
+        int color;
+        std::vector<int> vertices;
+    };
+    
+    const int DONE = -1;
+    int n = graph.getVertexCount();
+    int workers = threadCount > 0 ? threadCount
+                                  : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    
+    // Reverse adjacency (CSR) for backward searches
+    std::vector<int> revOffsets(n + 1, 0);
+    for (int u = 0; u < n; ++u) {
+        for (int w : graph.neighbors(u)) revOffsets[w + 1]++;
+    }
+    for (int i = 0; i < n; ++i) revOffsets[i + 1] += revOffsets[i];
+    std::vector<int> revTargets(revOffsets[n]);
+    {
+        std::vector<int> fill(revOffsets.begin(), revOffsets.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            for (int w : graph.neighbors(u)) revTargets[fill[w]++] = u;
+        }
+    }
+    
+    std::vector<std::vector<int>> sccs;
+    std::vector<std::atomic<int>> color(n);
+    for (auto& c : color) c.store(0, std::memory_order_relaxed);
+    
+    // Step 1: trim trivial SCCs until no source/sink vertex is left
+    std::vector<int> inDeg(n), outDeg(n), trimQueue;
+    for (int v = 0; v < n; ++v) {
+        outDeg[v] = static_cast<int>(graph.neighbors(v).size());
+        inDeg[v] = revOffsets[v + 1] - revOffsets[v];
+        if (inDeg[v] == 0 || outDeg[v] == 0) trimQueue.push_back(v);
+    }
+    for (size_t head = 0; head < trimQueue.size(); ++head) {
+        int v = trimQueue[head];
+        if (color[v].load(std::memory_order_relaxed) == DONE) continue;
+        color[v].store(DONE, std::memory_order_relaxed);
+        sccs.push_back({v});
+        
+        for (int w : graph.neighbors(v)) {
+            if (color[w].load(std::memory_order_relaxed) != DONE && --inDeg[w] == 0) trimQueue.push_back(w);
+        }
+        for (int i = revOffsets[v]; i < revOffsets[v + 1]; ++i) {
+            int u = revTargets[i];
+            if (color[u].load(std::memory_order_relaxed) != DONE && --outDeg[u] == 0) trimQueue.push_back(u);
         }
     }
+    
+    Task initial{0, {}};
+    for (int v = 0; v < n; ++v) {
+        if (color[v].load(std::memory_order_relaxed) != DONE) initial.vertices.push_back(v);
+    }
+    if (initial.vertices.empty()) return sccs;
+    
+    // Step 2: forward-backward splitting; every split forks pool tasks
+    std::vector<char> forwardMark(n, 0), backwardMark(n, 0);
+    std::vector<int> rindex(n, 0);
+    std::atomic<int> nextColor{1};
+    std::mutex resultMutex;
+    ThreadPool& pool = ThreadPool::shared();
+    TaskGroup group(pool);
+    std::atomic<int> busy{1};   // slots in use; the calling thread holds one
+    auto acquireSlot = [&]() {
+        int current = busy.load(std::memory_order_relaxed);
+        while (current < workers) {
+            if (busy.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel)) return true;
+        }
+        return false;
+    };
+    
+    auto reach = [&](int pivot, int c, std::vector<char>& mark, bool backward) {
+        std::vector<int> frontier{pivot};
+        mark[pivot] = 1;
+        for (size_t head = 0; head < frontier.size(); ++head) {
+            int v = frontier[head];
+            const int* it = backward ? revTargets.data() + revOffsets[v] : graph.neighbors(v).begin();
+            const int* end = backward ? revTargets.data() + revOffsets[v + 1] : graph.neighbors(v).end();
+            for (; it != end; ++it) {
+                int w = *it;
+                // Color first: the marks of other subproblems' vertices belong to other tasks
+                if (color[w].load(std::memory_order_relaxed) == c && !mark[w]) {
+                    mark[w] = 1;
+                    frontier.push_back(w);
+                }
+            }
+        }
+    };
+    
+    std::function<void(Task)> process;
+    process = [&](Task first) {
+        std::vector<Task> kept{std::move(first)};     // parts no slot was free for
+        while (!kept.empty()) {
+            Task task = std::move(kept.back());
+            kept.pop_back();
+            int c = task.color;
+            
+            if (task.vertices.size() <= PARALLEL_SEQUENTIAL_CUTOFF) {
+                std::vector<std::vector<int>> local;
+                pearceSCC(graph, task.vertices,
+                          [&](int w) { return color[w].load(std::memory_order_relaxed) == c; },
+                          rindex, local);
+                std::lock_guard<std::mutex> lock(resultMutex);
+                for (auto& component : local) sccs.push_back(std::move(component));
+                continue;
+            }
+            
+            // Pivot with the largest in*out degree is most likely in a big SCC
+            int pivot = task.vertices[0];
+            long long best = -1;
+            for (int v : task.vertices) {
+                long long score = static_cast<long long>(graph.neighbors(v).size()) *
+                                  (revOffsets[v + 1] - revOffsets[v]);
+                if (score > best) {
+                    best = score;
+                    pivot = v;
+                }
+            }
+            
+            if (task.vertices.size() >= PARALLEL_SPLIT_REACH_CUTOFF && acquireSlot()) {
+                auto backwardSearch = pool.submit([&]() { reach(pivot, c, backwardMark, true); });
+                reach(pivot, c, forwardMark, false);
+                backwardSearch.get();
+                busy.fetch_sub(1, std::memory_order_acq_rel);
+            } else {
+                reach(pivot, c, forwardMark, false);
+                reach(pivot, c, backwardMark, true);
+            }
+            
+            std::vector<int> component;
+            Task parts[3] = {{nextColor++, {}}, {nextColor++, {}}, {nextColor++, {}}};
+            for (int v : task.vertices) {
+                int part = forwardMark[v] ? (backwardMark[v] ? -1 : 0) : (backwardMark[v] ? 1 : 2);
+                forwardMark[v] = backwardMark[v] = 0;
+                if (part < 0) {
+                    color[v].store(DONE, std::memory_order_relaxed);
+                    component.push_back(v);
+                } else {
+                    color[v].store(parts[part].color, std::memory_order_relaxed);
+                    parts[part].vertices.push_back(v);
+                }
+            }
+            
+            // Keep the largest part, fork the others for idle workers to steal
+            // while slots are free
+            std::sort(std::begin(parts), std::end(parts), [](const Task& a, const Task& b) {
+                return a.vertices.size() > b.vertices.size();
+            });
+            {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                sccs.push_back(std::move(component));
+            }
+            for (int i = 1; i < 3; ++i) {
+                if (parts[i].vertices.empty()) continue;
+                if (acquireSlot()) {
+                    group.run([&, part = std::move(parts[i])]() mutable {
+                        process(std::move(part));
+                        busy.fetch_sub(1, std::memory_order_acq_rel);
+                    });
+                } else {
+                    kept.push_back(std::move(parts[i]));
+                }
+            }
+            if (!parts[0].vertices.empty()) kept.push_back(std::move(parts[0]));
+        }
+    };
+    
+    process(std::move(initial));
+    // The caller only helps with queued tasks from here on
+    busy.fetch_sub(1, std::memory_order_acq_rel);
+    group.wait();
+    
+    // Completion order depends on scheduling; report components canonically
+    for (auto& component : sccs) std::sort(component.begin(), component.end());
+    std::sort(sccs.begin(), sccs.end());
+    return sccs;
 }
 
 Graph SCCAlgorithm::transposeGraph(const Graph& graph) {
@@ -95,12 +375,13 @@ Graph SCCAlgorithm::transposeGraph(const Graph& graph) {
     Graph transposed(n, true);
     
     for (int i = 0; i < n; ++i) {
-        auto neighbors = graph.getNeighbors(i);
+        NeighborRange neighbors = graph.neighbors(i);
         for (int neighbor : neighbors) {
             transposed.addEdge(neighbor, i);
         }
     }
     
+    transposed.freeze();
     return transposed;
 }
 
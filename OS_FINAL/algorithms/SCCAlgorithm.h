@@ -6,18 +6,39 @@
 
 class SCCAlgorithm : public AlgorithmStrategy {
 public:
+    // TARJAN: single iterative pass (Pearce's variant), no transposed copy.
+    // KOSARAJU: two passes over the graph and its transpose.
+    // PARALLEL: trimming + forward-backward splitting across worker threads.
+    enum class Mode { TARJAN, KOSARAJU, PARALLEL };
+
+    // threads is only used by PARALLEL; 0 means one per hardware thread.
+    // It caps how many searches run at once; they run on ThreadPool::shared(),
+    // so a pool with fewer workers is the tighter limit.
+    explicit SCCAlgorithm(Mode mode = Mode::TARJAN, int threads = 0) : mode(mode), threadCount(threads) {}
+
     AlgorithmResult execute(const Graph& graph) override;
     std::string getAlgorithmName() const override { return "Strongly Connected Components"; }
     std::string getDescription() const override { 
-        return "Finds strongly connected components using Kosaraju's algorithm"; 
+        switch (mode) {
+            case Mode::KOSARAJU: return "Finds strongly connected components using Kosaraju's algorithm";
+            case Mode::PARALLEL: return "Finds strongly connected components using parallel forward-backward search";
+            default: return "Finds strongly connected components using Tarjan's algorithm (Pearce's variant)";
+        }
     }
     bool supportsDirected() const override { return true; }
     bool supportsUndirected() const override { return false; }
+    Mode getMode() const { return mode; }
+
+    // Components as vertex lists, without formatting or timing
+    std::vector<std::vector<int>> findComponents(const Graph& graph);
 
 private:
-    void dfs1(const Graph& graph, int v, std::vector<bool>& visited, std::stack<int>& finishOrder);
-    void dfs2(const Graph& transposeGraph, int v, std::vector<bool>& visited, 
-              std::vector<int>& component);
+    Mode mode;
+    int threadCount;
+
+    std::vector<std::vector<int>> tarjan(const Graph& graph);
+    std::vector<std::vector<int>> kosaraju(const Graph& graph);
+    std::vector<std::vector<int>> parallel(const Graph& graph);
     Graph transposeGraph(const Graph& graph);
 };
 
@@ -0,0 +1,183 @@
+#include "../servers/BaseServer.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+
+// Server I/O backend benchmark: connection churn against a trivial
+// line-echo server on each BaseServer backend. Every client thread
+// repeatedly connects, sends a few requests, quits and reconnects.
+// Reports server-side I/O syscalls per request and request latency.
+//
+// Usage: bench_io [clients] [connections_per_client] [requests_per_connection] [port]
+
+class EchoServer : public BaseServer {
+public:
+    EchoServer(int port, IoBackend backend) : BaseServer(port, "Echo Server", backend) {}
+
+    ~EchoServer() {
+        stop();
+    }
+
+protected:
+    std::string welcomeMessage(int) override {
+        return "> ";
+    }
+
+    std::string handleLine(int, const std::string& line, bool& closeAfterReply) override {
+        if (line == "quit") {
+            closeAfterReply = true;
+            return "Goodbye!\n";
+        }
+        return line + "\n";
+    }
+};
+
+static int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read until the buffer ends with the given terminator
+static bool readUntil(int fd, const std::string& terminator) {
+    std::string data;
+    char buffer[4096];
+    while (data.size() < terminator.size() ||
+           data.compare(data.size() - terminator.size(), terminator.size(), terminator) != 0) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return false;
+        data.append(buffer, n);
+    }
+    return true;
+}
+
+static void clientLoop(int port, int connections, int requests, std::vector<double>& latencies,
+                       int& failures) {
+    const std::string request = "mst 4 4 0-1:3 1-2:1 2-3:4 3-0:2\n";
+    for (int c = 0; c < connections; ++c) {
+        int fd = connectTo(port);
+        if (fd < 0 || !readUntil(fd, "> ")) {
+            failures++;
+            if (fd >= 0) close(fd);
+            continue;
+        }
+        for (int r = 0; r < requests; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+            if (!readUntil(fd, "\n")) {
+                failures++;
+                break;
+            }
+            auto end = std::chrono::steady_clock::now();
+            latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        send(fd, "quit\n", 5, MSG_NOSIGNAL);
+        readUntil(fd, "Goodbye!\n");
+        close(fd);
+    }
+}
+
+static void runBackend(IoBackend backend, int port, int clients, int connections, int requests) {
+    EchoServer server(port, backend);
+
+    // Connection logging would dominate the measurement; silence it
+    std::ostringstream discarded;
+    std::streambuf* original = std::cout.rdbuf(discarded.rdbuf());
+    server.start();
+    IoBackend actual = server.getBackend();
+    unsigned long long syscallsBefore = server.getIoSyscallCount();
+
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<int> failures(clients, 0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < clients; ++t) {
+        threads.emplace_back(clientLoop, port, connections, requests,
+                             std::ref(latencies[t]), std::ref(failures[t]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    unsigned long long syscalls = server.getIoSyscallCount() - syscallsBefore;
+    server.stop();
+    std::cout.rdbuf(original);
+
+    std::vector<double> all;
+    int failed = 0;
+    for (int t = 0; t < clients; ++t) {
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+        failed += failures[t];
+    }
+    std::sort(all.begin(), all.end());
+
+    auto percentile = [&all](double p) {
+        if (all.empty()) return 0.0;
+        size_t index = std::min(all.size() - 1, static_cast<size_t>(p * all.size()));
+        return all[index];
+    };
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::left << std::setw(10) << BaseServer::backendToString(actual) << std::right
+              << std::setw(10) << all.size()
+              << std::setw(12) << std::fixed << std::setprecision(2)
+              << (all.empty() ? 0.0 : static_cast<double>(syscalls) / all.size())
+              << std::setw(12) << std::setprecision(1) << percentile(0.50)
+              << std::setw(12) << percentile(0.99)
+              << std::setw(14) << std::setprecision(0) << all.size() / seconds;
+    if (failed > 0) {
+        std::cout << "  (" << failed << " failures)";
+    }
+    std::cout << std::endl;
+
+    if (backend != IoBackend::AUTO && actual != backend) {
+        std::cout << "  note: " << BaseServer::backendToString(backend)
+                  << " unavailable, measured " << BaseServer::backendToString(actual) << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int clients = argc > 1 ? std::stoi(argv[1]) : 8;
+    int connections = argc > 2 ? std::stoi(argv[2]) : 500;
+    int requests = argc > 3 ? std::stoi(argv[3]) : 4;
+    int port = argc > 4 ? std::stoi(argv[4]) : 9500;
+
+    std::cout << "=== Server I/O Backend Benchmark ===" << std::endl;
+    std::cout << "Clients: " << clients << ", connections per client: " << connections
+              << ", requests per connection: " << requests << std::endl;
+    std::cout << std::left << std::setw(10) << "Backend" << std::right
+              << std::setw(10) << "Requests"
+              << std::setw(12) << "Syscall/req"
+              << std::setw(12) << "p50 (us)"
+              << std::setw(12) << "p99 (us)"
+              << std::setw(14) << "Requests/s" << std::endl;
+
+    runBackend(IoBackend::IO_URING, port, clients, connections, requests);
+    runBackend(IoBackend::EPOLL, port + 1, clients, connections, requests);
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "../common/Graph.h"
+#include "../algorithms/MSTAlgorithm.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <string>
+
+// MST scaling benchmark: parallel Boruvka from 1 to N threads against the
+// serial Kruskal (radix sort + union-find) and Prim (d-ary heap) engines on a
+// random connected weighted graph.
+//
+// Usage: bench_mst [vertices] [edges] [max_threads] [runs] [seed]
+
+static Graph makeWeightedGraph(int vertices, long long edges, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> vertexDist(0, vertices - 1);
+    std::uniform_int_distribution<> weightDist(1, 1000000);
+    
+    Graph graph(vertices, false);
+    // Random spanning tree first so the graph is connected
+    for (int v = 1; v < vertices; ++v) {
+        graph.addEdge(v, std::uniform_int_distribution<>(0, v - 1)(gen), weightDist(gen));
+    }
+    long long maxEdges = 1LL * vertices * (vertices - 1) / 2;
+    while (graph.getEdgeCount() < std::min(edges, maxEdges)) {
+        int u = vertexDist(gen);
+        int v = vertexDist(gen);
+        if (u != v) graph.addEdge(u, v, weightDist(gen));
+    }
+    graph.freeze();
+    return graph;
+}
+
+static double timeEngine(MSTAlgorithm& engine, const Graph& graph, int runs, std::string& result) {
+    double best = 0;
+    for (int r = 0; r < runs; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        result = engine.execute(graph).result;
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (r == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int vertices = argc > 1 ? std::stoi(argv[1]) : 10000;
+    long long edges = argc > 2 ? std::stoll(argv[2]) : 200000;
+    int maxThreads = argc > 3 ? std::stoi(argv[3]) : std::max(4u, std::thread::hardware_concurrency());
+    int runs = argc > 4 ? std::stoi(argv[4]) : 5;
+    unsigned int seed = argc > 5 ? std::stoul(argv[5]) : 42;
+    
+    Graph graph = makeWeightedGraph(vertices, edges, seed);
+    
+    std::cout << "=== MST Scaling Benchmark ===" << std::endl;
+    std::cout << "Graph: " << vertices << " vertices, " << graph.getEdgeCount()
+              << " weighted edges, seed=" << seed << std::endl;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency()
+              << ", best of " << runs << " runs" << std::endl << std::endl;
+    
+    std::string expected, result;
+    MSTAlgorithm kruskal(MSTAlgorithm::Mode::KRUSKAL);
+    MSTAlgorithm prim(MSTAlgorithm::Mode::PRIM);
+    double kruskalMs = timeEngine(kruskal, graph, runs, expected);
+    double primMs = timeEngine(prim, graph, runs, result);
+    bool consistent = (result == expected);
+    
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(18) << "engine" << std::setw(12) << "time(ms)"
+              << std::setw(12) << "vs kruskal" << "result" << std::endl;
+    std::cout << std::setw(18) << "kruskal" << std::setw(12) << kruskalMs
+              << std::setw(12) << 1.0 << expected << std::endl;
+    std::cout << std::setw(18) << "prim" << std::setw(12) << primMs
+              << std::setw(12) << (kruskalMs / primMs) << result << std::endl;
+    
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        MSTAlgorithm boruvka(MSTAlgorithm::Mode::BORUVKA, threads);
+        double ms = timeEngine(boruvka, graph, runs, result);
+        consistent = consistent && (result == expected);
+        
+        std::string label = "boruvka x" + std::to_string(threads);
+        std::cout << std::setw(18) << label << std::setw(12) << ms
+                  << std::setw(12) << (kruskalMs / ms) << result << std::endl;
+    }
+    
+    std::cout << std::endl << (consistent ? "✓ All engines agree" : "❌ MST weights differ") << std::endl;
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+#include "../q8/LFServer.h"
+#include "../q9/PipelineServer.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+
+// Multi-algorithm server benchmark: the q8 Leader-Follower server against
+// the q9 pipeline on a mixed workload (small and medium graphs, malformed
+// requests, stats). Every client keeps a window of requests in flight on
+// one connection and measures each reply's latency. Each server runs once
+// with the per-request algorithm fan-out and once with serial execution.
+//
+// Usage: bench_pipeline [clients] [requests_per_client] [window] [port]
+
+static const char* WORKLOAD[] = {
+    "3 3 0-1 1-2 2-0",
+    "4 4 0-1:3 1-2:1 2-3:4 3-0:2",
+    "10 20 0-1 1-2 2-3 3-4 4-5 5-6 6-7 7-8 8-9 9-0 0-5 1-6 2-7 3-8 4-9 0-2 2-4 4-6 6-8 8-0",
+    "6 9 0-1 0-2 1-2 1-3 2-4 3-4 3-5 4-5 0-5",
+    "5 2 0-1 1-7",
+    "stats",
+    "8 12 0-1 1-2 2-3 3-0 4-5 5-6 6-7 7-4 0-4 1-5 2-6 3-7",
+    "not a graph",
+};
+static const size_t WORKLOAD_SIZE = sizeof(WORKLOAD) / sizeof(WORKLOAD[0]);
+
+// Every reply (results, errors, stats, welcome) ends with the prompt
+static const std::string PROMPT = "\n> ";
+
+static int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Reads until 'count' more prompts arrived; returns how many were seen
+static int readReplies(int fd, std::string& pending, int count) {
+    int seen = 0;
+    char buffer[65536];
+    while (seen < count) {
+        size_t pos = pending.find(PROMPT);
+        if (pos != std::string::npos) {
+            pending.erase(0, pos + PROMPT.size());
+            seen++;
+            continue;
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        pending.append(buffer, n);
+    }
+    return seen;
+}
+
+static void clientLoop(int port, int clientIndex, int requests, int window, std::vector<double>& latencies,
+                       int& failures) {
+    int fd = connectTo(port);
+    std::string pending;
+    if (fd < 0 || readReplies(fd, pending, 1) != 1) {
+        failures = requests;
+        if (fd >= 0) close(fd);
+        return;
+    }
+
+    std::vector<std::chrono::steady_clock::time_point> sentAt(requests);
+    int sent = 0;
+    int received = 0;
+    while (received < requests) {
+        while (sent < requests && sent - received < window) {
+            std::string line = std::string(WORKLOAD[(clientIndex + sent) % WORKLOAD_SIZE]) + "\n";
+            sentAt[sent] = std::chrono::steady_clock::now();
+            send(fd, line.data(), line.size(), MSG_NOSIGNAL);
+            sent++;
+        }
+        if (readReplies(fd, pending, 1) != 1) {
+            failures += requests - received;
+            break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(now - sentAt[received]).count());
+        received++;
+    }
+
+    send(fd, "quit\n", 5, MSG_NOSIGNAL);
+    close(fd);
+}
+
+template <typename CreateServer>
+static void runServer(const std::string& label, CreateServer createServer, int port, int clients, int requests,
+                      int window) {
+    // Per-request logging would dominate the measurement; silence it
+    std::ostringstream discarded;
+    std::streambuf* original = std::cout.rdbuf(discarded.rdbuf());
+    auto server = createServer();
+    server->start();
+
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<int> failures(clients, 0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < clients; ++t) {
+        threads.emplace_back(clientLoop, port, t, requests, window, std::ref(latencies[t]), std::ref(failures[t]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    server->stop();
+    server.reset();
+    std::cout.rdbuf(original);
+
+    std::vector<double> all;
+    int failed = 0;
+    for (int t = 0; t < clients; ++t) {
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+        failed += failures[t];
+    }
+    std::sort(all.begin(), all.end());
+
+    auto percentile = [&all](double p) {
+        if (all.empty()) return 0.0;
+        size_t index = std::min(all.size() - 1, static_cast<size_t>(p * all.size()));
+        return all[index];
+    };
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::left << std::setw(22) << label << std::right
+              << std::setw(10) << all.size()
+              << std::setw(12) << std::fixed << std::setprecision(1) << percentile(0.50)
+              << std::setw(12) << percentile(0.99)
+              << std::setw(14) << std::setprecision(0) << all.size() / seconds;
+    if (failed > 0) {
+        std::cout << "  (" << failed << " failures)";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int clients = argc > 1 ? std::stoi(argv[1]) : 8;
+    int requests = argc > 2 ? std::stoi(argv[2]) : 400;
+    int window = argc > 3 ? std::stoi(argv[3]) : 4;
+    int port = argc > 4 ? std::stoi(argv[4]) : 9600;
+
+    std::cout << "=== Multi-Algorithm Server Benchmark ===" << std::endl;
+    std::cout << "Clients: " << clients << ", requests per client: " << requests
+              << ", in flight per client: " << window << std::endl;
+    std::cout << std::left << std::setw(22) << "Server" << std::right
+              << std::setw(10) << "Requests"
+              << std::setw(12) << "p50 (us)"
+              << std::setw(12) << "p99 (us)"
+              << std::setw(14) << "Requests/s" << std::endl;
+
+    // The workload repeats a handful of graphs, so a result cache would
+    // answer nearly everything; keep it off to compare the servers themselves
+    const AlgorithmRunner::Mode modes[] = {AlgorithmRunner::Mode::SERIAL, AlgorithmRunner::Mode::FAN_OUT};
+    for (AlgorithmRunner::Mode mode : modes) {
+        std::string suffix = " (" + AlgorithmRunner::modeToString(mode) + ")";
+        runServer("q8 LF" + suffix, [port, mode]() { return std::make_unique<LFServer>(port, 4, mode, 0); },
+                  port, clients, requests, window);
+        runServer("q9 pipeline" + suffix,
+                  [port, mode]() { return std::make_unique<PipelineServer>(port + 1, 256, mode, 0); },
+                  port + 1, clients, requests, window);
+        port += 2;
+    }
+
+    return 0;
+}
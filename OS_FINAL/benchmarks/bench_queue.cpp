@@ -0,0 +1,153 @@
+#include "../threading/MPMCQueue.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+
+// Request queue benchmark: the bounded lock-free MPMC ring with futex
+// parking against the mutex + condition variable std::queue the
+// Leader-Follower server used to hand requests between threads.
+// Producers push request handles by value, consumers pop them; every run
+// checks that each handle arrives exactly once.
+//
+// Usage: bench_queue [items_per_producer] [capacity] [runs]
+
+struct RequestHandle {
+    uint32_t producer = 0;
+    uint32_t sequence = 0;
+};
+
+// The previous design: one mutex for the queue, consumers wait on a condvar
+class MutexQueue {
+public:
+    explicit MutexQueue(size_t) : closed(false) {}
+
+    bool push(RequestHandle value) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            requestQueue.push(value);
+        }
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(RequestHandle& value) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this] { return !requestQueue.empty() || closed; });
+        if (requestQueue.empty()) return false;
+        value = requestQueue.front();
+        requestQueue.pop();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            closed = true;
+        }
+        notEmpty.notify_all();
+    }
+
+private:
+    std::queue<RequestHandle> requestQueue;
+    std::mutex queueMutex;
+    std::condition_variable notEmpty;
+    bool closed;
+};
+
+template <typename Queue>
+static double runOnce(int producers, int consumers, int itemsPerProducer, size_t capacity, bool& valid) {
+    Queue queue(capacity);
+    std::vector<unsigned long long> sums(consumers, 0);
+    std::vector<long long> counts(consumers, 0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            RequestHandle handle;
+            while (queue.pop(handle)) {
+                sums[c] += handle.sequence + 1ULL * handle.producer * itemsPerProducer;
+                counts[c]++;
+            }
+        });
+    }
+    std::vector<std::thread> producerThreads;
+    for (int p = 0; p < producers; ++p) {
+        producerThreads.emplace_back([&, p] {
+            for (int i = 0; i < itemsPerProducer; ++i) {
+                RequestHandle handle;
+                handle.producer = p;
+                handle.sequence = i;
+                queue.push(handle);
+            }
+        });
+    }
+    for (auto& thread : producerThreads) thread.join();
+    queue.close();
+    for (auto& thread : threads) thread.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Handles are numbered 0..N-1 overall; check count and sum
+    unsigned long long total = 1ULL * producers * itemsPerProducer;
+    unsigned long long sum = 0;
+    long long count = 0;
+    for (int c = 0; c < consumers; ++c) {
+        sum += sums[c];
+        count += counts[c];
+    }
+    valid = valid && count == static_cast<long long>(total) && sum == total * (total - 1) / 2;
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+template <typename Queue>
+static double bestThroughput(int producers, int consumers, int items, size_t capacity, int runs, bool& valid) {
+    double best = 0;
+    for (int r = 0; r < runs; ++r) {
+        double seconds = runOnce<Queue>(producers, consumers, items, capacity, valid);
+        double rate = producers * static_cast<double>(items) / seconds;
+        if (rate > best) best = rate;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int items = argc > 1 ? std::stoi(argv[1]) : 200000;
+    size_t capacity = argc > 2 ? std::stoul(argv[2]) : 1024;
+    int runs = argc > 3 ? std::stoi(argv[3]) : 3;
+
+    std::cout << "=== Request Queue Benchmark ===" << std::endl;
+    std::cout << "Items per producer: " << items << ", ring capacity: " << capacity
+              << ", hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << std::left << std::setw(14) << "Prod x Cons" << std::right
+              << std::setw(18) << "mutex+cv (M/s)"
+              << std::setw(18) << "MPMC ring (M/s)"
+              << std::setw(10) << "Speedup" << std::endl;
+
+    const int configs[][2] = {{1, 1}, {2, 2}, {4, 4}, {1, 16}, {4, 16}, {16, 16}};
+    bool valid = true;
+    for (const auto& config : configs) {
+        int producers = config[0];
+        int consumers = config[1];
+        double mutexRate = bestThroughput<MutexQueue>(producers, consumers, items, capacity, runs, valid);
+        double ringRate = bestThroughput<BlockingMPMCQueue<RequestHandle>>(producers, consumers, items,
+                                                                           capacity, runs, valid);
+
+        std::cout << std::left << std::setw(14)
+                  << (std::to_string(producers) + " x " + std::to_string(consumers)) << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(18) << mutexRate / 1e6
+                  << std::setw(18) << ringRate / 1e6
+                  << std::setw(9) << ringRate / mutexRate << "x" << std::endl;
+    }
+
+    std::cout << std::endl << (valid ? "✓ Every handle delivered exactly once" : "❌ Lost or duplicated handles")
+              << std::endl;
+    return valid ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+#include "../common/EdgeToken.h"
+#include "../common/EdgeTokenizer.h"
+#include "../common/RequestStream.h"
+#include "../common/BinaryProtocol.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Wire format benchmark: decoding one large graph request from the text
+// protocol against a binary GBIN frame carrying the same edges. The text
+// is parsed three ways: istringstream + parseEdgeToken per edge (the line
+// parsers' way), EdgeTokenizer straight into a pre-sized array, and a
+// RequestStream fed in recv-sized chunks, as the servers now do.
+//
+// Usage: bench_wire [vertices] [edges] [runs] [seed]
+
+static std::vector<EdgeToken> makeEdges(int vertices, int edges, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> vertexDist(0, vertices - 1);
+    std::uniform_int_distribution<> weightDist(1, 1000);
+
+    std::vector<EdgeToken> list;
+    list.reserve(edges);
+    while (static_cast<int>(list.size()) < edges) {
+        int u = vertexDist(gen);
+        int v = vertexDist(gen);
+        if (u != v) list.push_back({u, v, weightDist(gen)});
+    }
+    return list;
+}
+
+static std::vector<EdgeToken> parseText(const std::string& line, int& vertices) {
+    std::istringstream iss(line);
+    int edges;
+    iss >> vertices >> edges;
+
+    std::vector<EdgeToken> list;
+    std::string edgeStr;
+    while (static_cast<int>(list.size()) < edges && iss >> edgeStr) {
+        list.push_back(parseEdgeToken(edgeStr));
+    }
+    return list;
+}
+
+static std::vector<EdgeToken> parseTokenizer(const std::string& line, int& vertices) {
+    char* rest;
+    vertices = static_cast<int>(strtol(line.c_str(), &rest, 10));
+    size_t edges = strtoul(rest, &rest, 10);
+    size_t offset = rest - line.c_str();
+
+    std::vector<EdgeToken> list(edges);
+    EdgeTokenizer::Scan scan = EdgeTokenizer::scan(line.data() + offset, line.size() - offset, list.data(), edges);
+    list.resize(scan.edges);
+    return list;
+}
+
+static std::vector<EdgeToken> parseStream(const std::string& line, int& vertices) {
+    const size_t chunk = 16384;
+    RequestStream stream(RequestStream::GraphLines::COUNTS);
+    for (size_t offset = 0; offset < line.size(); offset += chunk) {
+        stream.append(line.data() + offset, line.size() - offset < chunk ? line.size() - offset : chunk);
+    }
+    StreamMessage message;
+    stream.next(message);
+    vertices = message.vertices;
+    return std::move(message.edges);
+}
+
+static std::vector<EdgeToken> decodeBinary(const std::string& frame, int& vertices) {
+    size_t length = BinaryProtocol::frameLength(frame.data(), frame.size());
+    BinaryRequest request = BinaryProtocol::decodeRequest(frame.data(), length);
+    vertices = request.vertexCount;
+    return std::move(request.edges);
+}
+
+template <typename Decode>
+static double bestMillis(Decode decode, const std::string& message, int runs, size_t& decoded) {
+    double best = 0;
+    for (int r = 0; r < runs; ++r) {
+        int vertices = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<EdgeToken> edges = decode(message, vertices);
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (r == 0 || ms < best) best = ms;
+        decoded = edges.size();
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int vertices = argc > 1 ? std::stoi(argv[1]) : 1000;
+    int edges = argc > 2 ? std::stoi(argv[2]) : 500000;
+    int runs = argc > 3 ? std::stoi(argv[3]) : 5;
+    unsigned int seed = argc > 4 ? std::stoul(argv[4]) : 42;
+
+    std::vector<EdgeToken> list = makeEdges(vertices, edges, seed);
+
+    std::ostringstream text;
+    text << vertices << " " << edges;
+    for (const EdgeToken& edge : list) {
+        text << " " << edge.u << "-" << edge.v << ":" << edge.weight;
+    }
+    text << "\n";
+    std::string line = text.str();
+    std::string frame = BinaryProtocol::encodeRequest(vertices, list, 0x1f, true);
+
+    std::cout << "=== Wire Format Benchmark ===" << std::endl;
+    std::cout << "Request: " << vertices << " vertices, " << edges << " weighted edges, best of "
+              << runs << " runs" << std::endl << std::endl;
+
+    size_t textEdges = 0, tokenizerEdges = 0, streamEdges = 0, binaryEdges = 0;
+    double textMs = bestMillis(parseText, line, runs, textEdges);
+    double tokenizerMs = bestMillis(parseTokenizer, line, runs, tokenizerEdges);
+    double streamMs = bestMillis(parseStream, line, runs, streamEdges);
+    double binaryMs = bestMillis(decodeBinary, frame, runs, binaryEdges);
+
+    auto printRow = [&](const char* format, size_t bytes, double ms, size_t decoded) {
+        std::cout << std::left << std::setw(12) << format << std::right << std::setw(12) << bytes
+                  << std::setw(12) << std::setprecision(3) << ms
+                  << std::setw(16) << std::setprecision(1) << decoded / ms / 1000.0
+                  << std::setw(10) << std::setprecision(2) << textMs / ms << std::endl;
+    };
+
+    std::cout << std::fixed;
+    std::cout << std::left << std::setw(12) << "format" << std::right << std::setw(12) << "bytes"
+              << std::setw(12) << "time(ms)" << std::setw(16) << "Medges/s" << std::setw(10) << "speedup"
+              << std::endl;
+    printRow("text", line.size(), textMs, textEdges);
+    printRow("tokenizer", line.size(), tokenizerMs, tokenizerEdges);
+    printRow("stream", line.size(), streamMs, streamEdges);
+    printRow("binary", frame.size(), binaryMs, binaryEdges);
+
+    if (textEdges != list.size() || tokenizerEdges != list.size() || streamEdges != list.size() ||
+        binaryEdges != list.size()) {
+        std::cout << "Decoded edge counts differ!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include "BinaryProtocol.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const char REQUEST_MAGIC[4] = {'G', 'B', 'I', 'N'};
+const char BATCH_MAGIC[4] = {'G', 'B', 'A', 'T'};
+const char RESPONSE_MAGIC[4] = {'G', 'R', 'E', 'S'};
+
+// Byte-wise so the decoding is independent of host endianness and alignment
+uint16_t readU16(const char* p) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<uint16_t>(b[0] | b[1] << 8);
+}
+
+uint32_t readU32(const char* p) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<uint32_t>(b[0]) | static_cast<uint32_t>(b[1]) << 8 |
+           static_cast<uint32_t>(b[2]) << 16 | static_cast<uint32_t>(b[3]) << 24;
+}
+
+void writeU16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xff));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+void writeU32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+}
+
+}
+
+bool BinaryProtocol::isFrameStart(const char* data, size_t available) {
+    size_t prefix = std::min<size_t>(available, 4);
+    return available > 0 &&
+           (memcmp(data, REQUEST_MAGIC, prefix) == 0 || memcmp(data, BATCH_MAGIC, prefix) == 0);
+}
+
+bool BinaryProtocol::isBatch(const char* data) {
+    return memcmp(data, BATCH_MAGIC, 4) == 0;
+}
+
+FrameHeader BinaryProtocol::decodeHeader(const char* data) {
+    if (memcmp(data, REQUEST_MAGIC, 4) != 0) {
+        throw std::invalid_argument("Not a request frame");
+    }
+    uint8_t version = static_cast<uint8_t>(data[4]);
+    if (version != VERSION) {
+        throw std::invalid_argument("Unsupported frame version: " + std::to_string(version));
+    }
+
+    FrameHeader header;
+    header.flags = static_cast<uint8_t>(data[5]);
+    if (header.flags & ~WEIGHTED) {
+        throw std::invalid_argument("Unknown frame flags: " + std::to_string(header.flags));
+    }
+    header.algorithmMask = readU16(data + 6);
+    uint32_t vertexCount = readU32(data + 8);
+    if (vertexCount > static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("Vertex count out of range: " + std::to_string(vertexCount));
+    }
+    header.vertexCount = static_cast<int>(vertexCount);
+    header.edgeCount = readU32(data + 12);
+
+    uint64_t length = REQUEST_HEADER_SIZE + static_cast<uint64_t>(header.edgeCount) * edgeRecordSize(header);
+    if (length > MAX_FRAME_LENGTH) {
+        throw std::invalid_argument("Frame too large: " + std::to_string(length) + " bytes");
+    }
+    return header;
+}
+
+size_t BinaryProtocol::edgeRecordSize(const FrameHeader& header) {
+    return (header.flags & WEIGHTED) ? 12 : 8;
+}
+
+EdgeToken BinaryProtocol::decodeEdge(const char* record, const FrameHeader& header) {
+    uint32_t u = readU32(record);
+    uint32_t v = readU32(record + 4);
+    uint32_t vertexCount = static_cast<uint32_t>(header.vertexCount);
+    if (u >= vertexCount || v >= vertexCount) {
+        throw std::invalid_argument("Vertex out of range: " + std::to_string(u) + "-" + std::to_string(v));
+    }
+    EdgeToken edge;
+    edge.u = static_cast<int>(u);
+    edge.v = static_cast<int>(v);
+    edge.weight = (header.flags & WEIGHTED) ? static_cast<int32_t>(readU32(record + 8)) : 1;
+    return edge;
+}
+
+BatchHeader BinaryProtocol::decodeBatchHeader(const char* data) {
+    if (!isBatch(data)) {
+        throw std::invalid_argument("Not a batch frame");
+    }
+    uint8_t version = static_cast<uint8_t>(data[4]);
+    if (version != VERSION) {
+        throw std::invalid_argument("Unsupported frame version: " + std::to_string(version));
+    }
+
+    BatchHeader header;
+    header.flags = static_cast<uint8_t>(data[5]);
+    if (header.flags & ~WEIGHTED) {
+        throw std::invalid_argument("Unknown frame flags: " + std::to_string(header.flags));
+    }
+    header.algorithmMask = readU16(data + 6);
+    header.graphCount = readU32(data + 8);
+    header.bodyLength = readU32(data + 12);
+    if (header.graphCount > MAX_BATCH_GRAPHS) {
+        throw std::invalid_argument("Too many graphs in batch: " + std::to_string(header.graphCount));
+    }
+    uint64_t length = BATCH_HEADER_SIZE + static_cast<uint64_t>(header.bodyLength);
+    if (length > MAX_FRAME_LENGTH) {
+        throw std::invalid_argument("Frame too large: " + std::to_string(length) + " bytes");
+    }
+    if (header.bodyLength < static_cast<uint64_t>(header.graphCount) * BATCH_GRAPH_HEADER_SIZE) {
+        throw std::invalid_argument("Batch body too short for " + std::to_string(header.graphCount) + " graphs");
+    }
+    return header;
+}
+
+FrameHeader BinaryProtocol::decodeBatchGraph(const char* data, const BatchHeader& batch) {
+    uint32_t vertexCount = readU32(data);
+    if (vertexCount > static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("Vertex count out of range: " + std::to_string(vertexCount));
+    }
+    FrameHeader header;
+    header.flags = batch.flags;
+    header.algorithmMask = batch.algorithmMask;
+    header.vertexCount = static_cast<int>(vertexCount);
+    header.edgeCount = readU32(data + 4);
+    return header;
+}
+
+size_t BinaryProtocol::frameLength(const char* data, size_t available) {
+    if (available < REQUEST_HEADER_SIZE) {
+        return 0;
+    }
+    FrameHeader header = decodeHeader(data);
+    size_t length = REQUEST_HEADER_SIZE + header.edgeCount * edgeRecordSize(header);
+    return available >= length ? length : 0;
+}
+
+BinaryRequest BinaryProtocol::decodeRequest(const char* data, size_t length) {
+    if (frameLength(data, length) != length) {
+        throw std::invalid_argument("Incomplete request frame");
+    }
+
+    FrameHeader header = decodeHeader(data);
+    BinaryRequest request;
+    request.flags = header.flags;
+    request.algorithmMask = header.algorithmMask;
+    request.vertexCount = header.vertexCount;
+
+    // One allocation for the whole edge list, nothing per edge
+    size_t stride = edgeRecordSize(header);
+    request.edges.reserve(header.edgeCount);
+    const char* record = data + REQUEST_HEADER_SIZE;
+    for (uint32_t i = 0; i < header.edgeCount; ++i, record += stride) {
+        request.edges.push_back(decodeEdge(record, header));
+    }
+    return request;
+}
+
+std::string BinaryProtocol::encodeRequest(int vertexCount, const std::vector<EdgeToken>& edges,
+                                          uint16_t algorithmMask, bool weighted) {
+    uint8_t flags = weighted ? WEIGHTED : 0;
+    std::string frame;
+    frame.reserve(REQUEST_HEADER_SIZE + edges.size() * (weighted ? 12 : 8));
+    frame.append(REQUEST_MAGIC, 4);
+    frame.push_back(static_cast<char>(VERSION));
+    frame.push_back(static_cast<char>(flags));
+    writeU16(frame, algorithmMask);
+    writeU32(frame, static_cast<uint32_t>(vertexCount));
+    writeU32(frame, static_cast<uint32_t>(edges.size()));
+    for (const EdgeToken& edge : edges) {
+        writeU32(frame, static_cast<uint32_t>(edge.u));
+        writeU32(frame, static_cast<uint32_t>(edge.v));
+        if (weighted) {
+            writeU32(frame, static_cast<uint32_t>(edge.weight));
+        }
+    }
+    return frame;
+}
+
+std::string BinaryProtocol::encodeBatch(const std::vector<BinaryRequest>& graphs, uint16_t algorithmMask,
+                                        bool weighted) {
+    uint8_t flags = weighted ? WEIGHTED : 0;
+    std::string body;
+    for (const BinaryRequest& graph : graphs) {
+        writeU32(body, static_cast<uint32_t>(graph.vertexCount));
+        writeU32(body, static_cast<uint32_t>(graph.edges.size()));
+        for (const EdgeToken& edge : graph.edges) {
+            writeU32(body, static_cast<uint32_t>(edge.u));
+            writeU32(body, static_cast<uint32_t>(edge.v));
+            if (weighted) {
+                writeU32(body, static_cast<uint32_t>(edge.weight));
+            }
+        }
+    }
+
+    std::string frame;
+    frame.reserve(BATCH_HEADER_SIZE + body.size());
+    frame.append(BATCH_MAGIC, 4);
+    frame.push_back(static_cast<char>(VERSION));
+    frame.push_back(static_cast<char>(flags));
+    writeU16(frame, algorithmMask);
+    writeU32(frame, static_cast<uint32_t>(graphs.size()));
+    writeU32(frame, static_cast<uint32_t>(body.size()));
+    frame += body;
+    return frame;
+}
+
+std::string BinaryProtocol::encodeResponse(uint8_t status, const std::string& body) {
+    std::string frame;
+    frame.reserve(RESPONSE_HEADER_SIZE + body.size());
+    frame.append(RESPONSE_MAGIC, 4);
+    frame.push_back(static_cast<char>(VERSION));
+    frame.push_back(static_cast<char>(status));
+    writeU16(frame, 0);
+    writeU32(frame, static_cast<uint32_t>(body.size()));
+    frame += body;
+    return frame;
+}
+
+size_t BinaryProtocol::responseLength(const char* data, size_t available) {
+    if (available < RESPONSE_HEADER_SIZE) {
+        return 0;
+    }
+    if (memcmp(data, RESPONSE_MAGIC, 4) != 0 || static_cast<uint8_t>(data[4]) != VERSION) {
+        throw std::invalid_argument("Not a response frame");
+    }
+    uint64_t length = RESPONSE_HEADER_SIZE + static_cast<uint64_t>(readU32(data + 8));
+    if (length > MAX_FRAME_LENGTH) {
+        throw std::invalid_argument("Frame too large: " + std::to_string(length) + " bytes");
+    }
+    return available >= length ? static_cast<size_t>(length) : 0;
+}
@@ -0,0 +1,114 @@
+#ifndef BINARY_PROTOCOL_H
+#define BINARY_PROTOCOL_H
+
+#include "EdgeToken.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Length-prefixed binary framing, accepted on the same sockets as the text
+// protocol: a message starting with the request magic is a frame, anything
+// else is a text line. All integers are little-endian.
+//
+// Request frame (16-byte header, then the edges):
+//   "GBIN"  uint8 version  uint8 flags  uint16 algorithm mask
+//   uint32 vertex count    uint32 edge count
+//   edge count x (uint32 u, uint32 v[, int32 weight if WEIGHTED])
+//
+// Batch frame (16-byte header, then the graphs), many graphs sharing one
+// algorithm mask and one reply:
+//   "GBAT"  uint8 version  uint8 flags  uint16 algorithm mask
+//   uint32 graph count     uint32 body length (bytes after the header)
+//   graph count x (uint32 vertex count, uint32 edge count, edges as above)
+//
+// Response frame (12-byte header, then the reply text without the prompt):
+//   "GRES"  uint8 version  uint8 status  uint16 reserved  uint32 body length
+// A batch is answered by one response frame whose body holds one response
+// frame per graph, in request order.
+struct FrameHeader {
+    uint8_t flags = 0;
+    uint16_t algorithmMask = 0;     // bit i selects AlgorithmType i
+    int vertexCount = 0;
+    uint32_t edgeCount = 0;
+};
+
+struct BatchHeader {
+    uint8_t flags = 0;
+    uint16_t algorithmMask = 0;
+    uint32_t graphCount = 0;
+    uint32_t bodyLength = 0;
+};
+
+struct BinaryRequest {
+    uint8_t flags = 0;
+    uint16_t algorithmMask = 0;     // bit i selects AlgorithmType i
+    int vertexCount = 0;
+    std::vector<EdgeToken> edges;   // weight 1 unless the frame is WEIGHTED
+};
+
+class BinaryProtocol {
+public:
+    static const uint8_t VERSION = 1;
+    static const size_t REQUEST_HEADER_SIZE = 16;
+    static const size_t RESPONSE_HEADER_SIZE = 12;
+    static const size_t BATCH_HEADER_SIZE = 16;
+    static const size_t BATCH_GRAPH_HEADER_SIZE = 8;
+    static const size_t MAX_FRAME_LENGTH = 16 << 20;
+    static const uint32_t MAX_BATCH_GRAPHS = 1 << 16;
+
+    // Request flags
+    static const uint8_t WEIGHTED = 0x01;
+
+    // Response status
+    static const uint8_t STATUS_OK = 0;
+    static const uint8_t STATUS_ERROR = 1;
+
+    // True when the bytes could be the start of a request or batch frame (a
+    // prefix of the magic counts, so a frame split after one byte is still seen)
+    static bool isFrameStart(const char* data, size_t available);
+
+    // Given at least 4 bytes of a frame: is it a batch?
+    static bool isBatch(const char* data);
+
+    // Total length of the request frame at 'data', or 0 while the header is
+    // incomplete or the frame has not fully arrived. Throws
+    // std::invalid_argument for a header that can never become valid
+    // (unknown version or flags, oversized frame); the stream cannot be
+    // resynchronized after that.
+    static size_t frameLength(const char* data, size_t available);
+
+    // Piecewise decoding, for readers that consume a frame as it arrives:
+    // the header (REQUEST_HEADER_SIZE bytes, same checks as frameLength()),
+    // then edgeCount records of edgeRecordSize() bytes each
+    static FrameHeader decodeHeader(const char* data);
+    static size_t edgeRecordSize(const FrameHeader& header);
+
+    // Throws std::invalid_argument if a vertex is out of range
+    static EdgeToken decodeEdge(const char* record, const FrameHeader& header);
+
+    // Batches are decoded the same way: the header (BATCH_HEADER_SIZE bytes;
+    // throws like decodeHeader), then per graph its BATCH_GRAPH_HEADER_SIZE
+    // bytes, read into a FrameHeader carrying the batch's flags and mask,
+    // and that graph's edge records
+    static BatchHeader decodeBatchHeader(const char* data);
+    static FrameHeader decodeBatchGraph(const char* data, const BatchHeader& batch);
+
+    // Decodes one complete frame. Throws std::invalid_argument if a vertex is
+    // out of range; the remaining checks (self-loops, size limits, mask) are
+    // left to the server.
+    static BinaryRequest decodeRequest(const char* data, size_t length);
+
+    static std::string encodeRequest(int vertexCount, const std::vector<EdgeToken>& edges, uint16_t algorithmMask,
+                                     bool weighted = false);
+
+    static std::string encodeBatch(const std::vector<BinaryRequest>& graphs, uint16_t algorithmMask,
+                                   bool weighted = false);
+
+    static std::string encodeResponse(uint8_t status, const std::string& body);
+
+    // Same contract as frameLength(), for clients reading response frames
+    static size_t responseLength(const char* data, size_t available);
+};
+
+#endif
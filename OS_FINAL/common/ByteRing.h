@@ -0,0 +1,102 @@
+#ifndef BYTE_RING_H
+#define BYTE_RING_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+// Growable byte ring buffer for per-connection input.
+// Consuming from the front only moves an index, so a reader that takes a
+// few bytes at a time never shifts the rest of the buffer; the storage
+// doubles (and is straightened out) only when an append does not fit.
+class ByteRing {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    explicit ByteRing(size_t initialCapacity = 4096) : head(0), count(0) {
+        size_t capacity = 16;
+        while (capacity < initialCapacity) capacity <<= 1;
+        storage.resize(capacity);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void append(const char* data, size_t length) {
+        if (count + length > storage.size()) {
+            grow(count + length);
+        }
+        size_t tail = (head + count) & mask();
+        size_t first = std::min(length, storage.size() - tail);
+        memcpy(&storage[tail], data, first);
+        memcpy(&storage[0], data + first, length - first);
+        count += length;
+    }
+
+    char at(size_t offset) const { return storage[(head + offset) & mask()]; }
+
+    // The buffered bytes up to the end of the storage; the rest, if any,
+    // continues at the start of it
+    const char* front(size_t& length) const {
+        length = std::min(count, storage.size() - head);
+        return &storage[head];
+    }
+
+    void copy(size_t offset, size_t length, char* out) const {
+        size_t start = (head + offset) & mask();
+        size_t first = std::min(length, storage.size() - start);
+        memcpy(out, &storage[start], first);
+        memcpy(out + first, &storage[0], length - first);
+    }
+
+    std::string read(size_t offset, size_t length) const {
+        std::string out(length, '\0');
+        copy(offset, length, &out[0]);
+        return out;
+    }
+
+    // Offset of the first 'c' at or after 'from', or npos
+    size_t find(char c, size_t from) const {
+        while (from < count) {
+            size_t start = (head + from) & mask();
+            size_t run = std::min(count - from, storage.size() - start);
+            const void* hit = memchr(&storage[start], c, run);
+            if (hit) {
+                return from + (static_cast<const char*>(hit) - &storage[start]);
+            }
+            from += run;
+        }
+        return npos;
+    }
+
+    void consume(size_t length) {
+        head = (head + length) & mask();
+        count -= length;
+        if (count == 0) head = 0;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+private:
+    std::vector<char> storage;      // size is a power of two
+    size_t head;
+    size_t count;
+
+    size_t mask() const { return storage.size() - 1; }
+
+    void grow(size_t needed) {
+        size_t capacity = storage.size();
+        while (capacity < needed) capacity <<= 1;
+        std::vector<char> larger(capacity);
+        copy(0, count, larger.data());
+        storage.swap(larger);
+        head = 0;
+    }
+};
+
+#endif
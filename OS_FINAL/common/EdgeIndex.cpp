@@ -0,0 +1,112 @@
+#include "EdgeIndex.h"
+
+namespace {
+// Rough per-entry footprint of std::unordered_set<uint64_t> (node + bucket)
+const size_t HASHED_BYTES_PER_ENTRY = 32;
+// Matrices up to this size are always used, even for empty graphs
+const size_t SMALL_MATRIX_BYTES = 64 * 1024;
+}
+
+EdgeIndex::EdgeIndex(int v) 
+    : vertices(v), mode(chooseMode(v, 0)), entries(0), rowWords((v + 63) / 64) {
+    if (mode == Mode::BITSET_MATRIX) {
+        bits.assign(static_cast<size_t>(vertices) * rowWords, 0);
+    }
+}
+
+size_t EdgeIndex::matrixBytes(int vertices) {
+    return static_cast<size_t>(vertices) * ((vertices + 63) / 64) * sizeof(uint64_t);
+}
+
+EdgeIndex::Mode EdgeIndex::chooseMode(int vertices, size_t entries) {
+    size_t matrix = matrixBytes(vertices);
+    if (matrix <= SMALL_MATRIX_BYTES) {
+        return Mode::BITSET_MATRIX;
+    }
+    return matrix <= entries * HASHED_BYTES_PER_ENTRY ? Mode::BITSET_MATRIX : Mode::HASHED;
+}
+
+void EdgeIndex::insert(int u, int v) {
+    if (mode == Mode::BITSET_MATRIX) {
+        size_t bit = static_cast<size_t>(u) * rowWords * 64 + v;
+        uint64_t mask = 1ULL << (bit & 63);
+        if (!(bits[bit >> 6] & mask)) {
+            bits[bit >> 6] |= mask;
+            entries++;
+        }
+        return;
+    }
+    
+    if (edgeSet.insert(makeKey(u, v)).second) {
+        entries++;
+        // Dense enough that the bit matrix is now the smaller structure
+        if (entries * HASHED_BYTES_PER_ENTRY >= matrixBytes(vertices)) {
+            rebuild(Mode::BITSET_MATRIX);
+        }
+    }
+}
+
+void EdgeIndex::erase(int u, int v) {
+    if (mode == Mode::BITSET_MATRIX) {
+        size_t bit = static_cast<size_t>(u) * rowWords * 64 + v;
+        uint64_t mask = 1ULL << (bit & 63);
+        if (bits[bit >> 6] & mask) {
+            bits[bit >> 6] &= ~mask;
+            entries--;
+        }
+        return;
+    }
+    
+    entries -= edgeSet.erase(makeKey(u, v));
+}
+
+void EdgeIndex::clear() {
+    entries = 0;
+    edgeSet.clear();
+    mode = chooseMode(vertices, 0);
+    if (mode == Mode::BITSET_MATRIX) {
+        bits.assign(static_cast<size_t>(vertices) * rowWords, 0);
+    } else {
+        std::vector<uint64_t>().swap(bits);
+    }
+}
+
+void EdgeIndex::optimize() {
+    Mode best = chooseMode(vertices, entries);
+    if (best != mode) {
+        rebuild(best);
+    }
+}
+
+size_t EdgeIndex::memoryBytes() const {
+    if (mode == Mode::BITSET_MATRIX) {
+        return bits.size() * sizeof(uint64_t);
+    }
+    return entries * HASHED_BYTES_PER_ENTRY;
+}
+
+void EdgeIndex::rebuild(Mode newMode) {
+    if (newMode == Mode::BITSET_MATRIX) {
+        bits.assign(static_cast<size_t>(vertices) * rowWords, 0);
+        for (uint64_t key : edgeSet) {
+            size_t bit = static_cast<size_t>(key >> 32) * rowWords * 64 + static_cast<uint32_t>(key);
+            bits[bit >> 6] |= 1ULL << (bit & 63);
+        }
+        std::unordered_set<uint64_t>().swap(edgeSet);
+    } else {
+        edgeSet.reserve(entries);
+        for (size_t word = 0; word < bits.size(); ++word) {
+            uint64_t w = bits[word];
+            while (w) {
+                int offset = __builtin_ctzll(w);
+                size_t bit = word * 64 + offset;
+                int u = bit / (rowWords * 64);
+                int v = bit % (rowWords * 64);
+                edgeSet.insert(makeKey(u, v));
+                w &= w - 1;
+            }
+        }
+        std::vector<uint64_t>().swap(bits);
+    }
+    mode = newMode;
+}
@@ -0,0 +1,58 @@
+#ifndef EDGE_INDEX_H
+#define EDGE_INDEX_H
+
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include <cstddef>
+
+// Constant-time edge existence index used by Graph.
+// Small or dense graphs use a V x V bit matrix, large sparse graphs a hashed
+// set of (u, v) keys. The representation is picked from the vertex count and
+// number of stored entries, and migrates automatically as the graph grows.
+class EdgeIndex {
+public:
+    enum class Mode {
+        BITSET_MATRIX,
+        HASHED
+    };
+    
+    explicit EdgeIndex(int vertices = 0);
+    
+    // Directed entries: undirected graphs insert both (u, v) and (v, u)
+    void insert(int u, int v);
+    void erase(int u, int v);
+    bool contains(int u, int v) const {
+        if (mode == Mode::BITSET_MATRIX) {
+            size_t bit = static_cast<size_t>(u) * rowWords * 64 + v;
+            return (bits[bit >> 6] >> (bit & 63)) & 1ULL;
+        }
+        return edgeSet.count(makeKey(u, v)) != 0;
+    }
+    void clear();
+    
+    // Re-evaluate the representation for the current number of entries
+    void optimize();
+    
+    Mode getMode() const { return mode; }
+    size_t size() const { return entries; }
+    size_t memoryBytes() const;
+    
+    static Mode chooseMode(int vertices, size_t entries);
+    
+private:
+    int vertices;
+    Mode mode;
+    size_t entries;
+    size_t rowWords;
+    std::vector<uint64_t> bits;
+    std::unordered_set<uint64_t> edgeSet;
+    
+    static uint64_t makeKey(int u, int v) {
+        return (static_cast<uint64_t>(u) << 32) | static_cast<uint32_t>(v);
+    }
+    static size_t matrixBytes(int vertices);
+    void rebuild(Mode newMode);
+};
+
+#endif
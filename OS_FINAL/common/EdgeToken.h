@@ -0,0 +1,56 @@
+#ifndef EDGE_TOKEN_H
+#define EDGE_TOKEN_H
+
+#include <string>
+#include <stdexcept>
+
+// One edge on the text wire format: "u-v" (weight 1) or "u-v:w".
+// Shared by every server parser so the formats cannot drift apart.
+struct EdgeToken {
+    int u;
+    int v;
+    int weight;
+};
+
+// Throws std::invalid_argument for malformed tokens; range checks against
+// the graph size are left to the caller.
+inline EdgeToken parseEdgeToken(const std::string& token) {
+    size_t dashPos = token.find('-', 1);
+    if (dashPos == std::string::npos) {
+        throw std::invalid_argument("Invalid edge format: " + token + " (expected: u-v or u-v:w)");
+    }
+    size_t colonPos = token.find(':', dashPos + 1);
+    
+    EdgeToken edge;
+    try {
+        size_t used = 0;
+        edge.u = std::stoi(token.substr(0, dashPos), &used);
+        if (used != dashPos) throw std::invalid_argument(token);
+        
+        std::string target = token.substr(dashPos + 1, colonPos == std::string::npos ? std::string::npos
+                                                                                       : colonPos - dashPos - 1);
+        edge.v = std::stoi(target, &used);
+        if (used != target.size()) throw std::invalid_argument(token);
+        
+        edge.weight = 1;
+        if (colonPos != std::string::npos) {
+            std::string weight = token.substr(colonPos + 1);
+            edge.weight = std::stoi(weight, &used);
+            if (used != weight.size()) throw std::invalid_argument(token);
+        }
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid edge: " + token);
+    }
+    return edge;
+}
+
+// Inverse of parseEdgeToken, for error messages about decoded edges
+inline std::string edgeTokenToString(const EdgeToken& edge) {
+    std::string token = std::to_string(edge.u) + "-" + std::to_string(edge.v);
+    if (edge.weight != 1) {
+        token += ":" + std::to_string(edge.weight);
+    }
+    return token;
+}
+
+#endif
@@ -0,0 +1,145 @@
+#include "EdgeTokenizer.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Longest number taken on the fast path; 9 digits always fit in an int
+const size_t MAX_DIGITS = 9;
+
+int digitsValue(const char* p, size_t count) {
+    int value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        value = value * 10 + (p[i] - '0');
+    }
+    return value;
+}
+
+bool readNumber(const char*& p, const char* end, int& value) {
+    const char* start = p;
+    while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+        ++p;
+    }
+    size_t count = p - start;
+    if (count == 0 || count > MAX_DIGITS) {
+        return false;
+    }
+    value = digitsValue(start, count);
+    return true;
+}
+
+#ifdef __SSE2__
+unsigned byteMask(__m128i bytes, char c) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(c))));
+}
+
+// Parses the token at p from one 16-byte load. Needs 16 readable bytes;
+// false if the token is not plain or does not end within them.
+bool parseBlock(const char* p, size_t& tokenLength, EdgeToken& edge) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    unsigned separators = byteMask(bytes, ' ') | byteMask(bytes, '\n') | byteMask(bytes, '\t') |
+                          byteMask(bytes, '\r');
+    if (separators == 0) {
+        return false;
+    }
+    unsigned length = __builtin_ctz(separators);
+    unsigned token = (1u << length) - 1;
+
+    // Signed compares: bytes >= 0x80 are negative and never count as digits
+    __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                    _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+    unsigned digits = static_cast<unsigned>(_mm_movemask_epi8(isDigit)) & token;
+    unsigned dash = byteMask(bytes, '-') & token;
+    unsigned colon = byteMask(bytes, ':') & token;
+
+    // Digits everywhere except one '-' and at most one ':'
+    if ((digits | dash | colon) != token || dash == 0 || (dash & (dash - 1)) != 0 || (colon & (colon - 1)) != 0) {
+        return false;
+    }
+    unsigned dashAt = __builtin_ctz(dash);
+    unsigned colonAt = colon ? __builtin_ctz(colon) : length;
+    size_t uDigits = dashAt;
+    size_t vDigits = colonAt > dashAt ? colonAt - dashAt - 1 : 0;
+    size_t wDigits = colon ? length - colonAt - 1 : 1;
+    if (uDigits == 0 || vDigits == 0 || wDigits == 0 ||
+        uDigits > MAX_DIGITS || vDigits > MAX_DIGITS || wDigits > MAX_DIGITS) {
+        return false;
+    }
+
+    edge.u = digitsValue(p, uDigits);
+    edge.v = digitsValue(p + dashAt + 1, vDigits);
+    edge.weight = colon ? digitsValue(p + colonAt + 1, wDigits) : 1;
+    tokenLength = length;
+    return true;
+}
+#endif
+
+}
+
+bool EdgeTokenizer::parseToken(const char* token, size_t length, EdgeToken& edge) {
+    const char* p = token;
+    const char* end = token + length;
+    if (!readNumber(p, end, edge.u) || p == end || *p != '-') {
+        return false;
+    }
+    ++p;
+    if (!readNumber(p, end, edge.v)) {
+        return false;
+    }
+    edge.weight = 1;
+    if (p == end) {
+        return true;
+    }
+    if (*p != ':') {
+        return false;
+    }
+    ++p;
+    return readNumber(p, end, edge.weight) && p == end;
+}
+
+EdgeTokenizer::Scan EdgeTokenizer::scan(const char* data, size_t length, EdgeToken* out, size_t capacity) {
+    Scan result;
+    const char* p = data;
+    const char* end = data + length;
+
+    while (result.edges < capacity) {
+        while (p < end && isSeparator(*p)) {
+            ++p;
+        }
+        if (p == end) {
+            break;
+        }
+        if (*p == '\n') {
+            ++p;
+            result.lineEnded = true;
+            break;
+        }
+
+        size_t tokenLength = 0;
+        EdgeToken& edge = out[result.edges];
+#ifdef __SSE2__
+        if (end - p >= 16) {
+            if (!parseBlock(p, tokenLength, edge)) {
+                break;
+            }
+        } else
+#endif
+        {
+            const char* tokenEnd = p;
+            while (tokenEnd < end && !isSeparator(*tokenEnd) && *tokenEnd != '\n') {
+                ++tokenEnd;
+            }
+            tokenLength = tokenEnd - p;
+            if (tokenEnd == end || !parseToken(p, tokenLength, edge)) {
+                break;
+            }
+        }
+        p += tokenLength;
+        result.edges++;
+    }
+
+    result.consumed = p - data;
+    return result;
+}
@@ -0,0 +1,36 @@
+#ifndef EDGE_TOKENIZER_H
+#define EDGE_TOKENIZER_H
+
+#include "EdgeToken.h"
+#include <cstddef>
+
+// Allocation-free parser for the edge list of a text graph request
+// ("u-v u-v:w ..."). Token ends are found 16 bytes at a time with SSE2
+// where available, and the same load classifies the token's digits and
+// delimiters, so a plain edge is validated without a per-byte branch.
+//
+// Only plain tokens - "digits-digits" with an optional ":digits", each
+// number at most 9 digits - are handled here. Anything else (signs,
+// overlong numbers, garbage) is left to parseEdgeToken(), which accepts or
+// rejects it exactly as before, so both paths agree on every input.
+class EdgeTokenizer {
+public:
+    struct Scan {
+        size_t consumed = 0;        // bytes handled: separators and parsed tokens
+        size_t edges = 0;           // edges written to the output
+        bool lineEnded = false;     // stopped after consuming a '\n'
+    };
+
+    // Parses whole tokens from [data, data + length) into out[0, capacity).
+    // Stops at the end of the line, when the output is full, or in front of
+    // a token it cannot finish: one that runs to the end of the buffer (its
+    // rest may still be on the way) or one that is not plain.
+    static Scan scan(const char* data, size_t length, EdgeToken* out, size_t capacity);
+
+    // One complete token; false means "not plain, use parseEdgeToken()"
+    static bool parseToken(const char* token, size_t length, EdgeToken& edge);
+
+    static bool isSeparator(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+};
+
+#endif
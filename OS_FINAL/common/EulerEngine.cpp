@@ -0,0 +1,85 @@
+#include "EulerEngine.h"
+#include <algorithm>
+
+EulerEngine::EulerEngine(const Graph& g) : graph(g), edgeCount(0) {
+    int n = graph.getVertexCount();
+    bool directed = graph.isDirected();
+    auto edges = graph.getAllEdges();
+    edgeCount = edges.size();
+    
+    // Count incidences per vertex, then place them (counting sort)
+    offsets.assign(n + 1, 0);
+    for (const auto& edge : edges) {
+        offsets[edge.first + 1]++;
+        if (!directed) {
+            offsets[edge.second + 1]++;
+        }
+    }
+    for (int v = 0; v < n; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    
+    targets.resize(offsets[n]);
+    edgeIds.resize(offsets[n]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int id = 0; id < edgeCount; ++id) {
+        int u = edges[id].first;
+        int v = edges[id].second;
+        targets[fill[u]] = v;
+        edgeIds[fill[u]++] = id;
+        if (!directed) {
+            targets[fill[v]] = u;
+            edgeIds[fill[v]++] = id;
+        }
+    }
+}
+
+std::vector<int> EulerEngine::findCircuit() {
+    std::vector<int> circuit;
+    
+    if (!graph.hasEulerCircuit()) {
+        return circuit;
+    }
+    
+    int n = graph.getVertexCount();
+    
+    // Find starting vertex with non-zero degree
+    int start = 0;
+    for (int v = 0; v < n; ++v) {
+        if (offsets[v + 1] > offsets[v]) {
+            start = v;
+            break;
+        }
+    }
+    
+    cursor.assign(offsets.begin(), offsets.end() - 1);
+    usedEdges.assign((edgeCount + 63) / 64, 0);
+    
+    std::vector<int> stack;
+    stack.reserve(edgeCount + 1);
+    circuit.reserve(edgeCount + 1);
+    stack.push_back(start);
+    
+    while (!stack.empty()) {
+        int v = stack.back();
+        int& pos = cursor[v];
+        int end = offsets[v + 1];
+        
+        // Skip edges already traversed from the other endpoint
+        while (pos < end && isUsed(edgeIds[pos])) {
+            ++pos;
+        }
+        
+        if (pos < end) {
+            markUsed(edgeIds[pos]);
+            stack.push_back(targets[pos]);
+            ++pos;
+        } else {
+            circuit.push_back(v);
+            stack.pop_back();
+        }
+    }
+    
+    std::reverse(circuit.begin(), circuit.end());
+    return circuit;
+}
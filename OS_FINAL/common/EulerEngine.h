@@ -0,0 +1,39 @@
+#ifndef EULER_ENGINE_H
+#define EULER_ENGINE_H
+
+#include "Graph.h"
+#include <vector>
+#include <cstdint>
+
+// Linear-time Hierholzer engine for Euler circuits.
+// Every edge gets an ID; each vertex keeps a cursor into its incidence list
+// and traversed edges are marked in a bitmap, so the circuit is found in
+// O(V + E) without copying or mutating the Graph.
+class EulerEngine {
+public:
+    explicit EulerEngine(const Graph& graph);
+    
+    // Returns the circuit as a vertex sequence (first == last), or an empty
+    // vector if the graph has no Euler circuit.
+    std::vector<int> findCircuit();
+    
+    int getEdgeCount() const { return edgeCount; }
+    
+private:
+    const Graph& graph;
+    int edgeCount;
+    
+    // Incidence lists in CSR form: for vertex v, entries
+    // [offsets[v], offsets[v + 1]) hold (target vertex, edge ID)
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<int> edgeIds;
+    
+    std::vector<int> cursor;
+    std::vector<uint64_t> usedEdges;
+    
+    bool isUsed(int edgeId) const { return (usedEdges[edgeId >> 6] >> (edgeId & 63)) & 1ULL; }
+    void markUsed(int edgeId) { usedEdges[edgeId >> 6] |= 1ULL << (edgeId & 63); }
+};
+
+#endif
@@ -1,9 +1,11 @@
 #include "Graph.h"
+#include "GraphTraversal.h"
+#include "EulerEngine.h"
 #include <algorithm>
-#include <stack>
 #include <iomanip>
 
-Graph::Graph(int v, bool isDirected) : vertices(v), directed(isDirected) {
+Graph::Graph(int v, bool isDirected)
+    : vertices(v), directed(isDirected), weighted(false), frozen(false), indexBuilt(false) {
     if (v <= 0) {
         throw std::invalid_argument("Number of vertices must be positive, got: " + std::to_string(v));
     }
@@ -11,10 +13,17 @@ Graph::Graph(int v, bool isDirected) : vertices(v), directed(isDirected) {
         throw std::invalid_argument("Number of vertices too large (max 10000), got: " + std::to_string(v));
     }
     adjList.resize(v);
+    weightList.resize(v);
 }
 
 Graph::Graph(const Graph& other) 
-    : vertices(other.vertices), directed(other.directed), adjList(other.adjList) {
+    : vertices(other.vertices), adjList(other.adjList), weightList(other.weightList),
+      directed(other.directed), weighted(other.weighted),
+      frozen(other.frozen), rowOffsets(other.rowOffsets), colIndices(other.colIndices),
+      edgeWeights(other.edgeWeights), indexBuilt(other.hasEdgeIndex()) {
+    if (indexBuilt) {
+        edgeIndex = other.edgeIndex;
+    }
 }
 
 Graph& Graph::operator=(const Graph& other) {
@@ -22,11 +31,19 @@ Graph& Graph::operator=(const Graph& other) {
         vertices = other.vertices;
         directed = other.directed;
         adjList = other.adjList;
+        weightList = other.weightList;
+        weighted = other.weighted;
+        frozen = other.frozen;
+        rowOffsets = other.rowOffsets;
+        colIndices = other.colIndices;
+        edgeWeights = other.edgeWeights;
+        edgeIndex = other.hasEdgeIndex() ? other.edgeIndex : EdgeIndex();
+        indexBuilt = other.hasEdgeIndex();
     }
     return *this;
 }
 
-void Graph::addEdge(int u, int v) {
+void Graph::addEdge(int u, int v, int weight) {
     if (!isValidVertex(u)) {
         throw std::out_of_range("Vertex u=" + std::to_string(u) + " is out of range [0," + std::to_string(vertices-1) + "]");
     }
@@ -38,13 +55,21 @@ void Graph::addEdge(int u, int v) {
     }
     
     // Check if edge already exists
-    if (hasEdge(u, v)) {
+    if (containsEdge(u, v)) {
         return; // Silently ignore duplicate edges
     }
     
+    thaw();
     adjList[u].push_back(v);
+    weightList[u].push_back(weight);
+    if (indexBuilt) edgeIndex.insert(u, v);
     if (!directed) {
         adjList[v].push_back(u);
+        weightList[v].push_back(weight);
+        if (indexBuilt) edgeIndex.insert(v, u);
+    }
+    if (weight != 1) {
+        weighted = true;
     }
 }
 
@@ -53,40 +78,123 @@ void Graph::removeEdge(int u, int v) {
         return; // Silently ignore invalid vertices
     }
     
-    adjList[u].remove(v);
+    if (!containsEdge(u, v)) {
+        return;
+    }
+    
+    thaw();
+    eraseFromList(u, v);
+    if (indexBuilt) edgeIndex.erase(u, v);
     if (!directed) {
-        adjList[v].remove(u);
+        eraseFromList(v, u);
+        if (indexBuilt) edgeIndex.erase(v, u);
     }
 }
 
-std::vector<int> Graph::getNeighbors(int vertex) const {
-    if (!isValidVertex(vertex)) {
-        return std::vector<int>();
+bool Graph::containsEdge(int u, int v) {
+    // Short neighbor lists are cheaper to scan than to index
+    NeighborRange range = neighbors(u);
+    if (!indexBuilt && range.size() <= INDEX_SCAN_LIMIT) {
+        return std::find(range.begin(), range.end(), v) != range.end();
     }
-    return std::vector<int>(adjList[vertex].begin(), adjList[vertex].end());
+    return hasEdge(u, v);
 }
 
-bool Graph::isValidVertex(int vertex) const {
-    return vertex >= 0 && vertex < vertices;
+void Graph::buildEdgeIndex() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    if (indexBuilt.load(std::memory_order_relaxed)) {
+        return;
+    }
+    EdgeIndex index(vertices);
+    for (int u = 0; u < vertices; ++u) {
+        for (int v : neighbors(u)) {
+            index.insert(u, v);
+        }
+    }
+    index.optimize();
+    edgeIndex = std::move(index);
+    indexBuilt.store(true, std::memory_order_release);
 }
 
-bool Graph::hasEdge(int u, int v) const {
-    if (!isValidVertex(u) || !isValidVertex(v)) {
-        return false;
+EdgeIndex::Mode Graph::getEdgeIndexMode() const {
+    if (!hasEdgeIndex()) {
+        buildEdgeIndex();
+    }
+    return edgeIndex.getMode();
+}
+
+void Graph::eraseFromList(int u, int v) {
+    // Neighbor lists hold no duplicates, so at most one entry matches
+    auto& list = adjList[u];
+    auto it = std::find(list.begin(), list.end(), v);
+    if (it != list.end()) {
+        weightList[u].erase(weightList[u].begin() + (it - list.begin()));
+        list.erase(it);
+    }
+}
+
+int Graph::getEdgeWeight(int u, int v) const {
+    NeighborRange range = neighbors(u);
+    WeightRange weights = neighborWeights(u);
+    for (size_t i = 0; i < range.size(); ++i) {
+        if (range[i] == v) {
+            return weights[i];
+        }
     }
+    throw std::invalid_argument("No edge " + std::to_string(u) + "-" + std::to_string(v));
+}
+
+std::vector<int> Graph::getNeighbors(int vertex) const {
+    NeighborRange range = neighbors(vertex);
+    return std::vector<int>(range.begin(), range.end());
+}
+
+void Graph::freeze() {
+    if (frozen) return;
     
-    const auto& neighbors = adjList[u];
-    return std::find(neighbors.begin(), neighbors.end(), v) != neighbors.end();
+    rowOffsets.assign(vertices + 1, 0);
+    for (int i = 0; i < vertices; ++i) {
+        rowOffsets[i + 1] = rowOffsets[i] + adjList[i].size();
+    }
+    
+    colIndices.resize(rowOffsets[vertices]);
+    edgeWeights.resize(rowOffsets[vertices]);
+    for (int i = 0; i < vertices; ++i) {
+        std::copy(adjList[i].begin(), adjList[i].end(), colIndices.begin() + rowOffsets[i]);
+        std::copy(weightList[i].begin(), weightList[i].end(), edgeWeights.begin() + rowOffsets[i]);
+    }
+    
+    // Release the per-vertex storage; CSR is now the only copy
+    std::vector<std::vector<int>>().swap(adjList);
+    std::vector<std::vector<int>>().swap(weightList);
+    if (indexBuilt) edgeIndex.optimize();
+    frozen = true;
 }
 
-int Graph::getDegree(int vertex) const {
-    if (!isValidVertex(vertex)) {
-        return 0;
+void Graph::thaw() {
+    if (!frozen) return;
+    
+    adjList.assign(vertices, std::vector<int>());
+    weightList.assign(vertices, std::vector<int>());
+    for (int i = 0; i < vertices; ++i) {
+        adjList[i].assign(colIndices.begin() + rowOffsets[i], colIndices.begin() + rowOffsets[i + 1]);
+        weightList[i].assign(edgeWeights.begin() + rowOffsets[i], edgeWeights.begin() + rowOffsets[i + 1]);
     }
-    return adjList[vertex].size();
+    
+    std::vector<int>().swap(rowOffsets);
+    std::vector<int>().swap(colIndices);
+    std::vector<int>().swap(edgeWeights);
+    frozen = false;
+}
+
+int Graph::getDegree(int vertex) const {
+    return neighbors(vertex).size();
 }
 
 bool Graph::isEmpty() const {
+    if (frozen) {
+        return colIndices.empty();
+    }
     for (int i = 0; i < vertices; ++i) {
         if (!adjList[i].empty()) {
             return false;
@@ -97,23 +205,36 @@ bool Graph::isEmpty() const {
 
 int Graph::getEdgeCount() const {
     int count = 0;
-    for (int i = 0; i < vertices; ++i) {
-        count += adjList[i].size();
+    if (frozen) {
+        count = colIndices.size();
+    } else {
+        for (int i = 0; i < vertices; ++i) {
+            count += adjList[i].size();
+        }
     }
     return directed ? count : count / 2;
 }
 
 void Graph::clear() {
+    thaw();
     for (auto& list : adjList) {
         list.clear();
     }
+    for (auto& list : weightList) {
+        list.clear();
+    }
+    weighted = false;
+    edgeIndex = EdgeIndex();
+    indexBuilt = false;
 }
 
 std::vector<std::pair<int, int>> Graph::getAllEdges() const {
     std::vector<std::pair<int, int>> edges;
     
+    edges.reserve(getEdgeCount());
+    
     for (int u = 0; u < vertices; ++u) {
-        for (int v : adjList[u]) {
+        for (int v : neighbors(u)) {
             if (directed || u < v) { // Avoid duplicates in undirected graphs
                 edges.emplace_back(u, v);
             }
@@ -136,7 +257,7 @@ bool Graph::isConnected() const {
     if (start == -1) return true; // No edges - considered connected
     
     std::vector<bool> visited(vertices, false);
-    dfsUtil(start, visited);
+    GraphTraversal(*this).dfs(start, visited);
     
     // Check if all vertices with edges are visited
     for (int i = 0; i < vertices; ++i) {
@@ -147,15 +268,6 @@ bool Graph::isConnected() const {
     return true;
 }
 
-void Graph::dfsUtil(int v, std::vector<bool>& visited) const {
-    visited[v] = true;
-    for (int neighbor : adjList[v]) {
-        if (!visited[neighbor]) {
-            dfsUtil(neighbor, visited);
-        }
-    }
-}
-
 bool Graph::hasEulerCircuit() const {
     if (!isConnected()) {
         return false;
@@ -174,7 +286,7 @@ bool Graph::hasEulerCircuit() const {
     // For directed graph: in-degree must equal out-degree for all vertices
     std::vector<int> inDegree(vertices, 0);
     for (int i = 0; i < vertices; ++i) {
-        for (int neighbor : adjList[i]) {
+        for (int neighbor : neighbors(i)) {
             inDegree[neighbor]++;
         }
     }
@@ -187,47 +299,9 @@ bool Graph::hasEulerCircuit() const {
     return true;
 }
 
-std::vector<int> Graph::findEulerCircuit() {
-    std::vector<int> circuit;
-    
-    if (!hasEulerCircuit()) {
-        return circuit; // Empty if none exists
-    }
-    
-    // Create working copy for modification
-    Graph tempGraph = *this;
-    tempGraph.hierholzerAlgorithm(circuit);
-    
-    return circuit;
-}
-
-void Graph::hierholzerAlgorithm(std::vector<int>& circuit) {
-    // Find starting vertex with non-zero degree
-    int start = 0;
-    for (int i = 0; i < vertices; ++i) {
-        if (getDegree(i) > 0) {
-            start = i;
-            break;
-        }
-    }
-    
-    std::stack<int> stack;
-    stack.push(start);
-    
-    while (!stack.empty()) {
-        int v = stack.top();
-        
-        if (!adjList[v].empty()) {
-            int u = adjList[v].front();
-            removeEdge(v, u);
-            stack.push(u);
-        } else {
-            circuit.push_back(v);
-            stack.pop();
-        }
-    }
-    
-    std::reverse(circuit.begin(), circuit.end());
+std::vector<int> Graph::findEulerCircuit() const {
+    // Linear-time Hierholzer over edge IDs; the graph itself is not copied
+    return EulerEngine(*this).findCircuit();
 }
 
 void Graph::printGraph() const {
@@ -245,14 +319,15 @@ void Graph::printGraph() const {
     std::cout << "\nAdjacency List:" << std::endl;
     for (int i = 0; i < vertices; ++i) {
         std::cout << "Vertex " << std::setw(2) << i << ": ";
-        if (adjList[i].empty()) {
+        if (getDegree(i) == 0) {
             std::cout << "(isolated)";
         } else {
-            bool first = true;
-            for (int neighbor : adjList[i]) {
-                if (!first) std::cout << ", ";
-                std::cout << neighbor;
-                first = false;
+            NeighborRange range = neighbors(i);
+            WeightRange weights = neighborWeights(i);
+            for (size_t j = 0; j < range.size(); ++j) {
+                if (j > 0) std::cout << ", ";
+                std::cout << range[j];
+                if (weighted) std::cout << "(w=" << weights[j] << ")";
             }
         }
         std::cout << " (degree: " << getDegree(i) << ")" << std::endl;
@@ -1,16 +1,60 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include "EdgeIndex.h"
 #include <vector>
-#include <list>
 #include <iostream>
 #include <stdexcept>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+
+// Non-owning view over the neighbors of one vertex.
+// Valid until the graph is modified (or frozen/thawed).
+class NeighborRange {
+public:
+    NeighborRange() : first(nullptr), last(nullptr) {}
+    NeighborRange(const int* begin, const int* end) : first(begin), last(end) {}
+    
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    int operator[](size_t i) const { return first[i]; }
+    
+private:
+    const int* first;
+    const int* last;
+};
+
+// Edge weights are exposed the same way, aligned index-for-index with neighbors().
+typedef NeighborRange WeightRange;
 
 class Graph {
 private:
     int vertices;
-    std::vector<std::list<int>> adjList;
+    std::vector<std::vector<int>> adjList;
+    std::vector<std::vector<int>> weightList;   // weightList[u][i] is the weight of adjList[u][i]
     bool directed;
+    bool weighted;                              // some edge has a weight other than 1
+    
+    // Compressed sparse row (CSR) storage, valid only while frozen.
+    // Neighbors of v are colIndices[rowOffsets[v] .. rowOffsets[v + 1]).
+    bool frozen;
+    std::vector<int> rowOffsets;
+    std::vector<int> colIndices;
+    std::vector<int> edgeWeights;               // parallel to colIndices
+    
+    // O(1) edge existence lookups (bit matrix or hashed, chosen by density).
+    // Built on the first hasEdge(), or once a vertex gets too many neighbors
+    // to scan for duplicates, so graphs that never ask do not pay for it.
+    // A frozen graph shared between threads builds it once, under indexMutex.
+    mutable EdgeIndex edgeIndex;
+    mutable std::atomic<bool> indexBuilt;
+    mutable std::mutex indexMutex;
+    
+    // addEdge() scans neighbor lists up to this long for duplicates
+    static const size_t INDEX_SCAN_LIMIT = 32;
     
 public:
     // Constructor
@@ -21,20 +65,63 @@ public:
     Graph& operator=(const Graph& other);
     
     // Basic operations
-    void addEdge(int u, int v);
+    void addEdge(int u, int v, int weight = 1);
     void removeEdge(int u, int v);
     std::vector<int> getNeighbors(int vertex) const;
     
+    // Zero-copy neighbor access for hot loops (no allocation)
+    NeighborRange neighbors(int vertex) const {
+        if (!isValidVertex(vertex)) {
+            return NeighborRange();
+        }
+        if (frozen) {
+            const int* base = colIndices.data();
+            return NeighborRange(base + rowOffsets[vertex], base + rowOffsets[vertex + 1]);
+        }
+        const auto& list = adjList[vertex];
+        return NeighborRange(list.data(), list.data() + list.size());
+    }
+    
+    // Weights of the edges in neighbors(vertex), in the same order
+    WeightRange neighborWeights(int vertex) const {
+        if (!isValidVertex(vertex)) {
+            return WeightRange();
+        }
+        if (frozen) {
+            const int* base = edgeWeights.data();
+            return WeightRange(base + rowOffsets[vertex], base + rowOffsets[vertex + 1]);
+        }
+        const auto& list = weightList[vertex];
+        return WeightRange(list.data(), list.data() + list.size());
+    }
+    int getEdgeWeight(int u, int v) const;
+    bool isWeighted() const { return weighted; }
+    
     // Getters
     int getVertexCount() const { return vertices; }
     bool isDirected() const { return directed; }
     
+    // CSR storage: freeze() packs the per-vertex adjacency (and weight) vectors
+    // into contiguous arrays and releases them. Any later modification thaws the graph automatically.
+    void freeze();
+    bool isFrozen() const { return frozen; }
+    
     // Display
     void printGraph() const;
     
     // Validation
-    bool isValidVertex(int vertex) const;
-    bool hasEdge(int u, int v) const;
+    bool isValidVertex(int vertex) const { return vertex >= 0 && vertex < vertices; }
+    bool hasEdge(int u, int v) const {
+        if (!isValidVertex(u) || !isValidVertex(v)) {
+            return false;
+        }
+        if (!indexBuilt.load(std::memory_order_acquire)) {
+            buildEdgeIndex();
+        }
+        return edgeIndex.contains(u, v);
+    }
+    bool hasEdgeIndex() const { return indexBuilt.load(std::memory_order_acquire); }
+    EdgeIndex::Mode getEdgeIndexMode() const;
     int getDegree(int vertex) const;
     
     // Graph properties
@@ -44,15 +131,17 @@ public:
     
     // Euler circuit methods (for requirements 2-3)
     bool hasEulerCircuit() const;
-    std::vector<int> findEulerCircuit();
+    std::vector<int> findEulerCircuit() const;
     
     // Utility methods
     void clear();
     std::vector<std::pair<int, int>> getAllEdges() const;
     
 private:
-    void dfsUtil(int v, std::vector<bool>& visited) const;
-    void hierholzerAlgorithm(std::vector<int>& circuit);
+    void thaw();
+    void eraseFromList(int u, int v);
+    void buildEdgeIndex() const;
+    bool containsEdge(int u, int v);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,380 @@
+#include "GraphSignature.h"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+typedef std::array<int, 3> EdgeTriple;     // (u, v, weight)
+
+uint64_t mix(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// Neighbours of every vertex as packed (color slot, weight, direction) keys;
+// directed graphs list out-arcs and in-arcs so refinement can tell them apart
+struct Arc {
+    int to;
+    uint64_t label;             // weight << 2 | direction
+};
+
+std::vector<std::vector<Arc>> collectArcs(const Graph& graph) {
+    int n = graph.getVertexCount();
+    std::vector<std::vector<Arc>> arcs(n);
+    for (int u = 0; u < n; ++u) {
+        NeighborRange neighbors = graph.neighbors(u);
+        WeightRange weights = graph.neighborWeights(u);
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            uint64_t weight = static_cast<uint32_t>(weights[i]);
+            if (graph.isDirected()) {
+                arcs[u].push_back({neighbors[i], weight << 2 | 1});
+                arcs[neighbors[i]].push_back({u, weight << 2 | 2});
+            } else {
+                arcs[u].push_back({neighbors[i], weight << 2});
+            }
+        }
+    }
+    return arcs;
+}
+
+// 1-dimensional Weisfeiler-Lehman refinement. Every round gives each vertex
+// the signature (own color, sorted neighbour (color, weight, direction)
+// multiset) and renumbers the colors by signature order, until no cell
+// splits. Colors end up ordinal (0 .. cells-1) and only depend on the input
+// coloring and the structure, never on vertex labels. Returns the number of
+// cells; with 'trace' set, every round's sorted signatures are hashed into it.
+int refine(const std::vector<std::vector<Arc>>& arcs, std::vector<int>& colors, uint64_t* trace = nullptr) {
+    int n = static_cast<int>(colors.size());
+    std::vector<std::vector<uint64_t>> signatures(n);
+    std::vector<int> order(n);
+
+    std::vector<int> distinct(colors);
+    std::sort(distinct.begin(), distinct.end());
+    int cells = static_cast<int>(std::unique(distinct.begin(), distinct.end()) - distinct.begin());
+
+    for (;;) {
+        for (int v = 0; v < n; ++v) {
+            std::vector<uint64_t>& signature = signatures[v];
+            signature.clear();
+            for (const Arc& arc : arcs[v]) {
+                signature.push_back(static_cast<uint64_t>(colors[arc.to]) << 40 | arc.label);
+            }
+            std::sort(signature.begin(), signature.end());
+        }
+
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            if (colors[a] != colors[b]) return colors[a] < colors[b];
+            return signatures[a] < signatures[b];
+        });
+
+        std::vector<int> refined(n);
+        int next = 0;
+        for (int i = 0; i < n; ++i) {
+            int v = order[i];
+            if (i > 0) {
+                int previous = order[i - 1];
+                if (colors[v] != colors[previous] || signatures[v] != signatures[previous]) {
+                    next++;
+                }
+            }
+            refined[v] = next;
+            if (trace && (i == 0 || refined[v] != refined[order[i - 1]])) {
+                *trace = mix(*trace, static_cast<uint64_t>(next) << 32 | signatures[v].size());
+                for (uint64_t key : signatures[v]) {
+                    *trace = mix(*trace, key);
+                }
+            }
+        }
+        colors.swap(refined);
+
+        if (next + 1 == cells) {
+            return cells;
+        }
+        cells = next + 1;
+    }
+}
+
+// Individualization-refinement search for the smallest edge list over all
+// labelings the refinement cannot tell apart. Automorphisms found along the
+// way (two leaves with the same edge list) prune children that lie in the
+// same orbit as an already explored sibling.
+class CanonicalSearch {
+public:
+    CanonicalSearch(const Graph& graph)
+        : graph(graph), n(graph.getVertexCount()), arcs(collectArcs(graph)), nodes(0), exhausted(false) {}
+
+    bool run(std::vector<EdgeTriple>& certificate, std::vector<int>& labels) {
+        seedTwinAutomorphisms();
+        std::vector<int> colors(n, 0);
+        refine(arcs, colors);
+        std::vector<int> prefix;
+        search(colors, prefix);
+        if (exhausted || bestLabels.empty()) {
+            return false;
+        }
+        certificate = best;
+        labels = bestLabels;
+        return true;
+    }
+
+private:
+    static const size_t MAX_AUTOMORPHISMS = 64;
+
+    const Graph& graph;
+    int n;
+    std::vector<std::vector<Arc>> arcs;
+    size_t nodes;
+    bool exhausted;
+
+    std::vector<EdgeTriple> best;
+    std::vector<int> bestLabels;            // vertex -> position in the best leaf
+    std::vector<int> bestVertexAt;          // position -> vertex
+    std::vector<std::vector<int>> automorphisms;
+    size_t seeded = 0;                      // leading entries that came from twins
+
+    // Twins - vertices with the same weighted neighbourhood apart from each
+    // other - can be swapped freely. Seeding those swaps up front lets the
+    // orbit pruning collapse cliques, independent sets and stars at once
+    // instead of rediscovering every symmetry leaf by leaf.
+    void seedTwinAutomorphisms() {
+        const int NO_EDGE = std::numeric_limits<int>::min();
+        std::vector<int> weight(n * n, NO_EDGE);
+        for (int u = 0; u < n; ++u) {
+            NeighborRange neighbors = graph.neighbors(u);
+            WeightRange weights = graph.neighborWeights(u);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                weight[u * n + neighbors[i]] = weights[i];
+            }
+        }
+        auto twins = [&](int u, int v) {
+            if (weight[u * n + v] != weight[v * n + u]) return false;
+            for (int x = 0; x < n; ++x) {
+                if (x == u || x == v) continue;
+                if (weight[u * n + x] != weight[v * n + x] || weight[x * n + u] != weight[x * n + v]) return false;
+            }
+            return true;
+        };
+
+        // Twin classes are equivalence classes; swapping consecutive members
+        // generates every permutation of a class
+        std::vector<bool> assigned(n, false);
+        for (int u = 0; u < n; ++u) {
+            if (assigned[u]) continue;
+            int last = u;
+            for (int v = u + 1; v < n; ++v) {
+                if (assigned[v] || !twins(u, v)) continue;
+                assigned[v] = true;
+                std::vector<int> swap(n);
+                std::iota(swap.begin(), swap.end(), 0);
+                std::swap(swap[last], swap[v]);
+                automorphisms.push_back(std::move(swap));
+                last = v;
+            }
+        }
+        seeded = automorphisms.size();
+    }
+
+    std::vector<EdgeTriple> certificateOf(const std::vector<int>& labels) const {
+        std::vector<EdgeTriple> edges;
+        for (int u = 0; u < n; ++u) {
+            NeighborRange neighbors = graph.neighbors(u);
+            WeightRange weights = graph.neighborWeights(u);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                int a = labels[u];
+                int b = labels[neighbors[i]];
+                if (graph.isDirected() || a < b) {
+                    edges.push_back({a, b, weights[i]});
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+
+    void leaf(const std::vector<int>& labels) {
+        std::vector<EdgeTriple> certificate = certificateOf(labels);
+        if (bestLabels.empty() || certificate < best) {
+            best.swap(certificate);
+            bestLabels = labels;
+            bestVertexAt.assign(n, 0);
+            for (int v = 0; v < n; ++v) {
+                bestVertexAt[labels[v]] = v;
+            }
+        } else if (certificate == best && automorphisms.size() < seeded + MAX_AUTOMORPHISMS) {
+            // Same edge list: mapping each vertex to the vertex holding its
+            // position in the best leaf preserves every edge
+            std::vector<int> automorphism(n);
+            for (int v = 0; v < n; ++v) {
+                automorphism[v] = bestVertexAt[labels[v]];
+            }
+            automorphisms.push_back(std::move(automorphism));
+        }
+    }
+
+    // Orbits of the known automorphisms that fix the current prefix, as a
+    // representative per vertex
+    std::vector<int> orbitsFixing(const std::vector<int>& prefix) const {
+        std::vector<int> parent(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&parent](int x) {
+            while (parent[x] != x) {
+                x = parent[x] = parent[parent[x]];
+            }
+            return x;
+        };
+        for (const auto& automorphism : automorphisms) {
+            bool fixesPrefix = true;
+            for (int p : prefix) {
+                fixesPrefix = fixesPrefix && automorphism[p] == p;
+            }
+            if (!fixesPrefix) continue;
+            for (int u = 0; u < n; ++u) {
+                parent[find(u)] = find(automorphism[u]);
+            }
+        }
+        for (int u = 0; u < n; ++u) {
+            parent[u] = find(u);
+        }
+        return parent;
+    }
+
+    void search(const std::vector<int>& colors, std::vector<int>& prefix) {
+        if (++nodes > GraphSignature::CANONICAL_NODE_BUDGET) {
+            exhausted = true;
+            return;
+        }
+
+        // Target the first non-singleton cell; colors are ordinal
+        std::vector<int> cellSize(n, 0);
+        for (int color : colors) {
+            cellSize[color]++;
+        }
+        int target = -1;
+        for (int color = 0; color < n && target < 0; ++color) {
+            if (cellSize[color] > 1) target = color;
+        }
+        if (target < 0) {
+            leaf(colors);
+            return;
+        }
+
+        // A child in the orbit of an explored sibling (under automorphisms
+        // fixing the prefix) leads to the same certificates; skip it
+        std::vector<bool> orbitExplored(n, false);
+        std::vector<int> orbit;
+        size_t knownAutomorphisms = static_cast<size_t>(-1);
+        for (int v = 0; v < n && !exhausted; ++v) {
+            if (colors[v] != target) {
+                continue;
+            }
+            if (automorphisms.size() != knownAutomorphisms) {
+                knownAutomorphisms = automorphisms.size();
+                std::vector<int> previous = orbit;
+                orbit = orbitsFixing(prefix);
+                // Orbits only ever merge, so explored marks carry over
+                std::vector<bool> marks(n, false);
+                for (int u = 0; u < n && !previous.empty(); ++u) {
+                    if (orbitExplored[previous[u]]) marks[orbit[u]] = true;
+                }
+                orbitExplored.swap(marks);
+            }
+            if (orbitExplored[orbit[v]]) {
+                continue;
+            }
+            // v gets a color of its own, ahead of the rest of its cell
+            std::vector<int> child(n);
+            for (int u = 0; u < n; ++u) {
+                child[u] = 2 * colors[u] + (colors[u] == target && u != v ? 1 : 0);
+            }
+            refine(arcs, child);
+
+            prefix.push_back(v);
+            search(child, prefix);
+            prefix.pop_back();
+            orbitExplored[orbit[v]] = true;
+        }
+    }
+};
+
+std::string pack(char tag, int vertices, const std::vector<EdgeTriple>& edges) {
+    std::string bytes(1 + sizeof(int) + edges.size() * sizeof(EdgeTriple), '\0');
+    char* out = &bytes[0];
+    *out++ = tag;
+    std::memcpy(out, &vertices, sizeof(int));
+    out += sizeof(int);
+    if (!edges.empty()) {
+        std::memcpy(out, edges.data(), edges.size() * sizeof(EdgeTriple));
+    }
+    return bytes;
+}
+
+}
+
+uint64_t hashBytes(const std::string& bytes, uint64_t seed) {
+    uint64_t hash = 1469598103934665603ULL ^ seed;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+GraphSignature GraphSignature::of(const Graph& graph) {
+    int vertices = graph.getVertexCount();
+    bool directed = graph.isDirected();
+
+    // Undirected edges are stored in both directions; keep u < v once
+    std::vector<EdgeTriple> edges;
+    for (int u = 0; u < vertices; ++u) {
+        NeighborRange neighbors = graph.neighbors(u);
+        WeightRange weights = graph.neighborWeights(u);
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            int v = neighbors[i];
+            if (directed || u < v) {
+                edges.push_back({u, v, weights[i]});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    GraphSignature signature;
+    signature.canonical = pack(directed ? 'D' : 'U', vertices, edges);
+    signature.hash = hashBytes(signature.canonical);
+    signature.kind = Kind::EXACT;
+    return signature;
+}
+
+bool GraphSignature::canonicalOf(const Graph& graph, GraphSignature& signature) {
+    if (graph.getVertexCount() > MAX_CANONICAL_VERTICES) {
+        return false;
+    }
+    std::vector<EdgeTriple> certificate;
+    std::vector<int> labels;
+    if (!CanonicalSearch(graph).run(certificate, labels)) {
+        return false;
+    }
+
+    // Lower-case tags keep canonical forms apart from exact ones
+    signature.canonical = pack(graph.isDirected() ? 'd' : 'u', graph.getVertexCount(), certificate);
+    signature.hash = hashBytes(signature.canonical);
+    signature.kind = Kind::CANONICAL;
+    signature.labels.swap(labels);
+    return true;
+}
+
+uint64_t GraphSignature::fingerprint(const Graph& graph) {
+    uint64_t trace = mix(graph.isDirected() ? 1 : 2, static_cast<uint64_t>(graph.getVertexCount()));
+    std::vector<int> colors(graph.getVertexCount(), 0);
+    refine(collectArcs(graph), colors, &trace);
+    return hashBytes(std::string(reinterpret_cast<const char*>(&trace), sizeof(trace)));
+}
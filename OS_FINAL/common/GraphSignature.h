@@ -0,0 +1,45 @@
+#ifndef GRAPH_SIGNATURE_H
+#define GRAPH_SIGNATURE_H
+
+#include "Graph.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Content address of a graph.
+// EXACT signatures compare vertex count, direction and the weighted edge set
+// as labelled, whatever order the edges were added in. CANONICAL signatures
+// additionally ignore vertex labels: relabelled (isomorphic) copies of a
+// graph share one.
+struct GraphSignature {
+    enum class Kind {
+        EXACT,
+        CANONICAL
+    };
+
+    // Canonical labelling searches an individualization-refinement tree, which
+    // explodes on large, highly symmetric graphs; give up past these limits
+    static const int MAX_CANONICAL_VERTICES = 64;
+    static const size_t CANONICAL_NODE_BUDGET = 256;
+
+    std::string canonical;      // packed direction, vertex count and sorted (u, v, weight) triples
+    uint64_t hash = 0;          // 64-bit hash of 'canonical'
+    Kind kind = Kind::EXACT;
+    std::vector<int> labels;    // CANONICAL only: vertex -> its label in the canonical form
+
+    static GraphSignature of(const Graph& graph);
+
+    // False when the graph is too large or the search exceeds its budget
+    static bool canonicalOf(const Graph& graph, GraphSignature& signature);
+
+    // Weisfeiler-Lehman color refinement fingerprint. Isomorphic graphs always
+    // agree; non-isomorphic ones usually differ, but e.g. regular graphs of the
+    // same degree and size collide, so it only ever rules isomorphism out.
+    // Much cheaper than canonicalOf, so it screens graphs before canonicalizing.
+    static uint64_t fingerprint(const Graph& graph);
+};
+
+// FNV-1a followed by a 64-bit finalizer, so nearby inputs spread over all bits
+uint64_t hashBytes(const std::string& bytes, uint64_t seed = 0);
+
+#endif
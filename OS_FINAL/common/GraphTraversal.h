@@ -0,0 +1,87 @@
+#ifndef GRAPH_TRAVERSAL_H
+#define GRAPH_TRAVERSAL_H
+
+#include "Graph.h"
+#include <vector>
+
+// Iterative DFS/BFS engine.
+// Uses explicit stacks reserved up front (one frame per vertex at most), so
+// traversal depth is bounded by heap memory instead of the thread stack -
+// a 10k-vertex path graph is safe on small-stack worker threads.
+// The engine can be reused for many traversals over the same graph.
+class GraphTraversal {
+public:
+    explicit GraphTraversal(const Graph& g) : graph(g) {
+        stack.reserve(g.getVertexCount());
+        queue.reserve(g.getVertexCount());
+    }
+    
+    // Depth-first search from start over unvisited vertices.
+    // onDiscover(v) runs in pre-order, onFinish(v) in post-order.
+    template <typename Discover, typename Finish>
+    void dfs(int start, std::vector<bool>& visited, Discover onDiscover, Finish onFinish) {
+        if (visited[start]) return;
+        
+        visited[start] = true;
+        onDiscover(start);
+        stack.push_back(Frame(start, graph.neighbors(start)));
+        
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next == top.last) {
+                int finished = top.vertex;
+                stack.pop_back();
+                onFinish(finished);
+                continue;
+            }
+            
+            int neighbor = *top.next++;
+            if (!visited[neighbor]) {
+                visited[neighbor] = true;
+                onDiscover(neighbor);
+                // May reallocate only if more than V frames - impossible, reserved
+                stack.push_back(Frame(neighbor, graph.neighbors(neighbor)));
+            }
+        }
+    }
+    
+    void dfs(int start, std::vector<bool>& visited) {
+        dfs(start, visited, [](int) {}, [](int) {});
+    }
+    
+    // Breadth-first search from start; onVisit(v) runs in BFS order.
+    template <typename Visit>
+    void bfs(int start, std::vector<bool>& visited, Visit onVisit) {
+        if (visited[start]) return;
+        
+        queue.clear();
+        queue.push_back(start);
+        visited[start] = true;
+        
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int v = queue[head];
+            onVisit(v);
+            for (int neighbor : graph.neighbors(v)) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+    }
+    
+private:
+    struct Frame {
+        int vertex;
+        const int* next;
+        const int* last;
+        
+        Frame(int v, const NeighborRange& range) : vertex(v), next(range.begin()), last(range.end()) {}
+    };
+    
+    const Graph& graph;
+    std::vector<Frame> stack;
+    std::vector<int> queue;
+};
+
+#endif
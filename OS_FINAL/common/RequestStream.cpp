@@ -0,0 +1,371 @@
+#include "RequestStream.h"
+#include <stdexcept>
+
+namespace {
+
+// Strict decimal int: optional '-', digits only
+bool parseInt(const std::string& token, int& value) {
+    size_t i = (!token.empty() && token[0] == '-') ? 1 : 0;
+    if (i == token.size() || token.size() - i > 10) return false;
+    long long result = 0;
+    for (; i < token.size(); ++i) {
+        if (token[i] < '0' || token[i] > '9') return false;
+        result = result * 10 + (token[i] - '0');
+    }
+    if (token[0] == '-') result = -result;
+    if (result < INT32_MIN || result > INT32_MAX) return false;
+    value = static_cast<int>(result);
+    return true;
+}
+
+// Declared counts come from the client; let the vector grow past this
+const size_t MAX_EDGE_RESERVE = 1 << 16;
+const size_t MAX_GRAPH_RESERVE = 1 << 10;
+
+}
+
+RequestStream::RequestStream(GraphLines graphLines, size_t maxLineLength)
+    : graphLines(graphLines), maxLineLength(maxLineLength), state(State::START), scanned(0),
+      parsedEdges(0), frameEdgesLeft(0), batchGraphsLeft(0), batchBytesLeft(0), failureInFrame(false) {}
+
+void RequestStream::append(const char* data, size_t length) {
+    if (state == State::FAILED) {
+        return;
+    }
+    ring.append(data, length);
+
+    bool progress = true;
+    while (progress) {
+        switch (state) {
+            case State::START: progress = startMessage(); break;
+            case State::LINE_HEAD: progress = readLineHead(); break;
+            case State::LINE_REST: progress = readLineRest(); break;
+            case State::GRAPH_EDGES: progress = readGraphEdges(); break;
+            case State::FRAME_EDGES: progress = readFrameEdges(); break;
+            case State::BATCH_GRAPH: progress = readBatchGraph(); break;
+            case State::FAILED: progress = false; break;
+        }
+    }
+}
+
+bool RequestStream::next(StreamMessage& message) {
+    if (ready.empty()) {
+        return false;
+    }
+    message = std::move(ready.front());
+    ready.pop_front();
+    return true;
+}
+
+bool RequestStream::startMessage() {
+    if (ring.empty()) {
+        return false;
+    }
+
+    char magic[4];
+    size_t available = ring.size() < 4 ? ring.size() : 4;
+    ring.copy(0, available, magic);
+    if (!BinaryProtocol::isFrameStart(magic, available)) {
+        state = (graphLines == GraphLines::NONE) ? State::LINE_REST : State::LINE_HEAD;
+        return true;
+    }
+
+    if (ring.size() < BinaryProtocol::REQUEST_HEADER_SIZE) {
+        return false;
+    }
+    char header[BinaryProtocol::REQUEST_HEADER_SIZE];
+    ring.copy(0, sizeof(header), header);
+    if (BinaryProtocol::isBatch(header)) {
+        try {
+            batchHeader = BinaryProtocol::decodeBatchHeader(header);
+        } catch (const std::exception& e) {
+            fail(e.what(), true);
+            return false;
+        }
+        ring.consume(BinaryProtocol::BATCH_HEADER_SIZE);
+
+        current.kind = StreamMessage::Kind::BATCH;
+        current.algorithmMask = batchHeader.algorithmMask;
+        current.graphs.reserve(batchHeader.graphCount < MAX_GRAPH_RESERVE ? batchHeader.graphCount : MAX_GRAPH_RESERVE);
+        batchGraphsLeft = batchHeader.graphCount;
+        batchBytesLeft = batchHeader.bodyLength;
+        state = State::BATCH_GRAPH;
+        return true;
+    }
+
+    try {
+        frameHeader = BinaryProtocol::decodeHeader(header);
+    } catch (const std::exception& e) {
+        fail(e.what(), true);
+        return false;
+    }
+    ring.consume(sizeof(header));
+
+    current.kind = StreamMessage::Kind::FRAME;
+    current.vertices = frameHeader.vertexCount;
+    current.edgeCount = static_cast<int>(frameHeader.edgeCount);
+    current.algorithmMask = frameHeader.algorithmMask;
+    current.edges.reserve(frameHeader.edgeCount < MAX_EDGE_RESERVE ? frameHeader.edgeCount : MAX_EDGE_RESERVE);
+    frameEdgesLeft = frameHeader.edgeCount;
+    state = State::FRAME_EDGES;
+    return true;
+}
+
+bool RequestStream::readLineHead() {
+    // Split the start of the line into tokens until the counts are either
+    // all there or clearly missing
+    size_t wanted = (graphLines == GraphLines::COUNTS) ? 2 : 3;
+    size_t limit = ring.size() < HEAD_LIMIT ? ring.size() : HEAD_LIMIT;
+    std::vector<std::pair<size_t, size_t>> tokens;      // (offset, length)
+    size_t tokenStart = 0;
+    bool inToken = false;
+    bool lineEnded = false;
+    for (size_t i = 0; i < limit && tokens.size() < wanted; ++i) {
+        char c = ring.at(i);
+        bool boundary = EdgeTokenizer::isSeparator(c) || c == '\n';
+        if (inToken && boundary) {
+            tokens.emplace_back(tokenStart, i - tokenStart);
+            inToken = false;
+        } else if (!inToken && !boundary) {
+            tokenStart = i;
+            inToken = true;
+        }
+        if (c == '\n') {
+            lineEnded = true;
+            break;
+        }
+    }
+
+    // Where the counts start; an optional command is there when the first
+    // token is not a number
+    size_t first = wanted - 2;
+    if (graphLines == GraphLines::OPTIONAL_COMMAND_COUNTS && !tokens.empty()) {
+        int ignored;
+        first = parseInt(ring.read(tokens[0].first, tokens[0].second), ignored) ? 0 : 1;
+        wanted = first + 2;
+    }
+
+    if (tokens.size() < wanted) {
+        if (!lineEnded && ring.size() < HEAD_LIMIT) {
+            return false;
+        }
+        state = State::LINE_REST;
+        return true;
+    }
+
+    int vertices = 0;
+    int edgeCount = 0;
+    if (!parseInt(ring.read(tokens[first].first, tokens[first].second), vertices) ||
+        !parseInt(ring.read(tokens[first + 1].first, tokens[first + 1].second), edgeCount) ||
+        edgeCount < 0 || edgeCount > MAX_STREAMED_EDGES) {
+        // Not a well-formed graph request; the server's own parser reports why
+        state = State::LINE_REST;
+        return true;
+    }
+
+    current.kind = StreamMessage::Kind::GRAPH;
+    if (first > 0) {
+        current.text = ring.read(tokens[0].first, tokens[0].second);
+    }
+    current.vertices = vertices;
+    current.edgeCount = edgeCount;
+    ring.consume(tokens[first + 1].first + tokens[first + 1].second);
+    state = State::GRAPH_EDGES;
+    return true;
+}
+
+bool RequestStream::readLineRest() {
+    size_t newline = ring.find('\n', scanned);
+    if (newline == ByteRing::npos) {
+        scanned = ring.size();
+        if (ring.size() > maxLineLength) {
+            fail("Request line too long", false);
+        }
+        return false;
+    }
+
+    current.kind = StreamMessage::Kind::LINE;
+    current.text = ring.read(0, newline);
+    current.text.erase(current.text.find_last_not_of("\r\n") + 1);
+    ring.consume(newline + 1);
+    finish();
+    return true;
+}
+
+bool RequestStream::readGraphEdges() {
+    while (true) {
+        bool wanted = current.error.empty() && parsedEdges < static_cast<size_t>(current.edgeCount);
+        if (!wanted) {
+            // Nothing left to parse on this line; just find its end
+            size_t newline = ring.find('\n', 0);
+            if (newline == ByteRing::npos) {
+                ring.clear();
+                return false;
+            }
+            ring.consume(newline + 1);
+            finish();
+            return true;
+        }
+
+        size_t room;
+        EdgeToken* slots = edgeSlots(room);
+        if (scanned == 0) {
+            // Whole plain tokens go straight from the ring into the edge array
+            size_t run;
+            const char* data = ring.front(run);
+            EdgeTokenizer::Scan scan = EdgeTokenizer::scan(data, run, slots, room);
+            ring.consume(scan.consumed);
+            parsedEdges += scan.edges;
+            if (scan.lineEnded) {
+                finish();
+                return true;
+            }
+            if (scan.consumed > 0) {
+                continue;
+            }
+        }
+
+        // The next token is unfinished, wraps around the end of the ring or
+        // is not plain: take it byte by byte and let parseEdgeToken judge it
+        if (scanned == 0) {
+            while (!ring.empty() && EdgeTokenizer::isSeparator(ring.at(0))) {
+                ring.consume(1);
+            }
+            if (ring.empty()) {
+                return false;
+            }
+            if (ring.at(0) == '\n') {
+                ring.consume(1);
+                finish();
+                return true;
+            }
+        }
+
+        // Find the end of the token, resuming where the last call stopped
+        size_t end = scanned;
+        while (end < ring.size() && !EdgeTokenizer::isSeparator(ring.at(end)) && ring.at(end) != '\n') {
+            ++end;
+        }
+        scanned = 0;
+        if (end > MAX_TOKEN_LENGTH) {
+            // No edge is that long; the rest of the line is skipped
+            current.error = "Invalid edge: " + ring.read(0, MAX_TOKEN_LENGTH) + "...";
+            continue;
+        }
+        if (end == ring.size()) {
+            scanned = end;
+            return false;
+        }
+
+        try {
+            *slots = parseEdgeToken(ring.read(0, end));
+            parsedEdges++;
+        } catch (const std::exception& e) {
+            current.error = e.what();
+        }
+        ring.consume(end);
+    }
+}
+
+bool RequestStream::readFrameEdges() {
+    bool batch = (current.kind == StreamMessage::Kind::BATCH);
+    StreamMessage& target = batch ? current.graphs.back() : current;
+    size_t recordSize = BinaryProtocol::edgeRecordSize(frameHeader);
+    char record[12];
+    while (frameEdgesLeft > 0 && ring.size() >= recordSize) {
+        if (target.error.empty()) {
+            ring.copy(0, recordSize, record);
+            try {
+                target.edges.push_back(BinaryProtocol::decodeEdge(record, frameHeader));
+            } catch (const std::exception& e) {
+                target.error = e.what();
+            }
+        }
+        ring.consume(recordSize);
+        frameEdgesLeft--;
+    }
+    if (frameEdgesLeft > 0) {
+        return false;
+    }
+    if (batch) {
+        state = State::BATCH_GRAPH;
+    } else {
+        finish();
+    }
+    return true;
+}
+
+bool RequestStream::readBatchGraph() {
+    // The graph sizes must add up to the body length the header announced,
+    // or the next message would be read from the middle of this one
+    if (batchGraphsLeft == 0) {
+        if (batchBytesLeft != 0) {
+            fail("Batch body length mismatch", true);
+            return false;
+        }
+        finish();
+        return true;
+    }
+    if (ring.size() < BinaryProtocol::BATCH_GRAPH_HEADER_SIZE) {
+        return false;
+    }
+
+    char header[BinaryProtocol::BATCH_GRAPH_HEADER_SIZE];
+    ring.copy(0, sizeof(header), header);
+    try {
+        frameHeader = BinaryProtocol::decodeBatchGraph(header, batchHeader);
+    } catch (const std::exception& e) {
+        fail(e.what(), true);
+        return false;
+    }
+    uint64_t graphBytes = sizeof(header) +
+                          static_cast<uint64_t>(frameHeader.edgeCount) * BinaryProtocol::edgeRecordSize(frameHeader);
+    if (graphBytes > batchBytesLeft) {
+        fail("Batch body length mismatch", true);
+        return false;
+    }
+    ring.consume(sizeof(header));
+    batchBytesLeft -= static_cast<uint32_t>(graphBytes);
+    batchGraphsLeft--;
+
+    StreamMessage graph;
+    graph.kind = StreamMessage::Kind::FRAME;
+    graph.vertices = frameHeader.vertexCount;
+    graph.edgeCount = static_cast<int>(frameHeader.edgeCount);
+    graph.algorithmMask = frameHeader.algorithmMask;
+    graph.edges.reserve(frameHeader.edgeCount < MAX_EDGE_RESERVE ? frameHeader.edgeCount : MAX_EDGE_RESERVE);
+    current.graphs.push_back(std::move(graph));
+    frameEdgesLeft = frameHeader.edgeCount;
+    state = State::FRAME_EDGES;
+    return true;
+}
+
+EdgeToken* RequestStream::edgeSlots(size_t& room) {
+    // Declared counts come from the client, so the array grows in steps
+    // towards them instead of being sized for the whole count up front
+    if (parsedEdges == current.edges.size()) {
+        size_t declared = static_cast<size_t>(current.edgeCount);
+        size_t step = parsedEdges > MAX_EDGE_RESERVE ? parsedEdges : MAX_EDGE_RESERVE;
+        current.edges.resize(declared - parsedEdges < step ? declared : parsedEdges + step);
+    }
+    room = current.edges.size() - parsedEdges;
+    return current.edges.data() + parsedEdges;
+}
+
+void RequestStream::finish() {
+    if (current.kind == StreamMessage::Kind::GRAPH) {
+        current.edges.resize(parsedEdges);
+    }
+    ready.push_back(std::move(current));
+    current = StreamMessage();
+    state = State::START;
+    scanned = 0;
+    parsedEdges = 0;
+}
+
+void RequestStream::fail(const std::string& reason, bool inFrame) {
+    failureText = reason;
+    failureInFrame = inFrame;
+    state = State::FAILED;
+    ring.clear();
+}
@@ -0,0 +1,117 @@
+#ifndef REQUEST_STREAM_H
+#define REQUEST_STREAM_H
+
+#include "ByteRing.h"
+#include "EdgeTokenizer.h"
+#include "BinaryProtocol.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdint>
+
+// One request taken off a connection
+struct StreamMessage {
+    enum class Kind {
+        LINE,       // a text line that is not a graph request, delivered whole
+        GRAPH,      // a "[command] vertices edges u-v ..." line, parsed as it arrived
+        FRAME,      // a binary request frame (see BinaryProtocol.h), decoded as it arrived
+        BATCH       // a batch frame: one FRAME message per graph in 'graphs'
+    };
+
+    Kind kind = Kind::LINE;
+    std::string text;               // LINE: the line without "\r\n"; GRAPH: the command, if any
+    int vertices = 0;
+    int edgeCount = 0;              // as declared; 'edges' is shorter if the request was
+    std::vector<EdgeToken> edges;
+    uint16_t algorithmMask = 0;     // FRAME and BATCH
+    std::string error;              // first malformed edge; edges after it were skipped
+    std::vector<StreamMessage> graphs;
+};
+
+// Incremental parser for everything a client sends on one connection.
+// Bytes are fed in as they are received; text lines and binary frames are
+// told apart by their first bytes, and graph requests are parsed edge by
+// edge while they arrive (see EdgeTokenizer.h), so only the unfinished
+// token (or frame record) stays buffered - a large graph is never held
+// twice. Other lines are kept in a growable ring buffer until their '\n'
+// arrives.
+//
+// Vertex-count, edge-count and range checks are left to the server, which
+// knows its limits; a GRAPH message only guarantees well-formed counts.
+class RequestStream {
+public:
+    // Which text lines are parsed incrementally as graphs
+    enum class GraphLines {
+        NONE,               // none: every line is delivered whole
+        COUNTS,             // "vertices edges u-v ..."
+        COMMAND_COUNTS,     // "command vertices edges u-v ..."
+        OPTIONAL_COMMAND_COUNTS     // either; a first token that is a number starts the counts
+    };
+
+    static const size_t MAX_LINE_LENGTH = 1 << 20;
+    static const int MAX_STREAMED_EDGES = 1 << 21;
+
+    explicit RequestStream(GraphLines graphLines = GraphLines::NONE, size_t maxLineLength = MAX_LINE_LENGTH);
+
+    // Parses as far as the bytes allow; finished messages queue up for next()
+    void append(const char* data, size_t length);
+
+    bool next(StreamMessage& message);
+
+    // Set once the stream cannot continue (over-long line, broken frame
+    // header). Messages completed before that are still returned by next().
+    bool failed() const { return state == State::FAILED; }
+    const std::string& failure() const { return failureText; }
+    bool failedInFrame() const { return failureInFrame; }
+
+    // Bytes held back waiting for the rest of a message
+    size_t buffered() const { return ring.size(); }
+
+    // Finished messages not yet taken by next()
+    size_t pending() const { return ready.size(); }
+
+private:
+    enum class State {
+        START,              // between messages
+        LINE_HEAD,          // reading the first tokens of a text line
+        LINE_REST,          // a plain line: waiting for its '\n'
+        GRAPH_EDGES,        // parsing edge tokens of a graph line
+        FRAME_EDGES,        // decoding edge records of a frame (or of a batch graph)
+        BATCH_GRAPH,        // waiting for the next graph header of a batch
+        FAILED
+    };
+
+    // A graph line's counts must show up this early, or it is a plain line
+    static const size_t HEAD_LIMIT = 128;
+    static const size_t MAX_TOKEN_LENGTH = 64;
+
+    GraphLines graphLines;
+    size_t maxLineLength;
+    ByteRing ring;
+    State state;
+    size_t scanned;                 // ring bytes already searched in this state
+    StreamMessage current;
+    size_t parsedEdges;             // GRAPH: edges filled in; current.edges is sized ahead
+    FrameHeader frameHeader;
+    uint32_t frameEdgesLeft;
+    BatchHeader batchHeader;
+    uint32_t batchGraphsLeft;
+    uint32_t batchBytesLeft;        // body bytes not yet accounted to a graph
+    std::deque<StreamMessage> ready;
+    std::string failureText;
+    bool failureInFrame;
+
+    // Each returns false when it needs more bytes
+    bool startMessage();
+    bool readLineHead();
+    bool readLineRest();
+    bool readGraphEdges();
+    bool readFrameEdges();
+    bool readBatchGraph();
+
+    EdgeToken* edgeSlots(size_t& room);
+    void finish();
+    void fail(const std::string& reason, bool inFrame);
+};
+
+#endif
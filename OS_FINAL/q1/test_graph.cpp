@@ -1,6 +1,12 @@
 #include "../common/Graph.h"
+#include "../common/GraphSignature.h"
+#include "../common/RequestStream.h"
+#include "../common/EdgeTokenizer.h"
+#include "../common/BinaryProtocol.h"
 #include <iostream>
 #include <exception>
+#include <algorithm>
+#include <random>
 
 void testBasicOperations() {
     std::cout << "\n=== Test 1: Basic Graph Operations ===" << std::endl;
@@ -36,6 +42,13 @@ void testBasicOperations() {
         for (int n : neighbors) std::cout << n << " ";
         std::cout << std::endl;
         
+        // Test zero-copy neighbor view
+        NeighborRange view = g.neighbors(1);
+        bool sameView = view.size() == neighbors.size() &&
+                        std::equal(view.begin(), view.end(), neighbors.begin());
+        std::cout << "- Neighbor view matches copy: " << (sameView ? "Yes" : "No") << std::endl;
+        std::cout << "- Neighbor view of invalid vertex empty: " << (g.neighbors(7).empty() ? "Yes" : "No") << std::endl;
+        
     } catch (const std::exception& e) {
         std::cout << "❌ Error: " << e.what() << std::endl;
     }
@@ -209,6 +222,496 @@ void testCopyAndModify() {
     }
 }
 
+void testFrozenGraph() {
+    std::cout << "\n=== Test 6: Frozen (CSR) Graph ===" << std::endl;
+    
+    try {
+        Graph g(5, false);
+        g.addEdge(0, 1);
+        g.addEdge(1, 2);
+        g.addEdge(2, 3);
+        g.addEdge(3, 4);
+        g.addEdge(4, 0);
+        
+        int edgesBefore = g.getEdgeCount();
+        g.freeze();
+        std::cout << "✓ Graph frozen into CSR form" << std::endl;
+        
+        bool same = g.isFrozen() && g.getEdgeCount() == edgesBefore &&
+                    g.hasEdge(0, 1) && g.hasEdge(0, 4) && !g.hasEdge(1, 3) &&
+                    g.getDegree(2) == 2 && g.isConnected() && g.hasEulerCircuit();
+        std::cout << (same ? "✓" : "❌") << " Frozen graph answers match the adjacency lists" << std::endl;
+        
+        auto circuit = g.findEulerCircuit();
+        std::cout << (circuit.size() == 6 ? "✓" : "❌") << " Euler circuit found on frozen graph (length: " 
+                  << circuit.size() << ")" << std::endl;
+        
+        // Modifying a frozen graph thaws it transparently
+        g.addEdge(1, 3);
+        bool thawed = !g.isFrozen() && g.hasEdge(3, 1) && g.getEdgeCount() == edgesBefore + 1;
+        std::cout << (thawed ? "✓" : "❌") << " Modification after freeze thaws the graph" << std::endl;
+        
+        g.freeze();
+        g.removeEdge(1, 3);
+        std::cout << (!g.hasEdge(1, 3) && g.getEdgeCount() == edgesBefore ? "✓" : "❌")
+                  << " Edge removal after freeze works" << std::endl;
+        
+        g.freeze();
+        Graph copy(g);
+        std::cout << (copy.isFrozen() && copy.getAllEdges() == g.getAllEdges() ? "✓" : "❌")
+                  << " Copy of frozen graph keeps CSR storage" << std::endl;
+        copy.printGraph();
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
+void testEdgeIndex() {
+    std::cout << "\n=== Test 7: Edge Index Selection ===" << std::endl;
+    
+    try {
+        Graph small(50, false);
+        small.addEdge(0, 49);
+        std::cout << (small.getEdgeIndexMode() == EdgeIndex::Mode::BITSET_MATRIX ? "✓" : "❌")
+                  << " Small graph uses bit matrix index" << std::endl;
+        
+        Graph sparse(5000, false);
+        for (int i = 0; i < 4999; ++i) {
+            sparse.addEdge(i, i + 1);
+        }
+        sparse.addEdge(1, 0);
+        sparse.freeze();
+        bool lazyOk = !sparse.hasEdgeIndex() && sparse.getEdgeCount() == 4999;
+        std::cout << (lazyOk ? "✓" : "❌") << " Index not built until queried; duplicates still ignored" << std::endl;
+        bool sparseOk = sparse.getEdgeIndexMode() == EdgeIndex::Mode::HASHED &&
+                        sparse.hasEdge(1234, 1235) && sparse.hasEdge(1235, 1234) && !sparse.hasEdge(0, 2);
+        std::cout << (sparseOk ? "✓" : "❌") << " Large sparse graph uses hashed index" << std::endl;
+        
+        Graph dense(1000, true);
+        for (int i = 0; i < 1000; ++i) {
+            for (int j = 0; j < 200; ++j) {
+                if (i != j) dense.addEdge(i, j);
+            }
+        }
+        bool denseOk = dense.getEdgeIndexMode() == EdgeIndex::Mode::BITSET_MATRIX &&
+                       dense.hasEdge(999, 199) && !dense.hasEdge(199, 999);
+        std::cout << (denseOk ? "✓" : "❌") << " Growing dense graph migrates to bit matrix" << std::endl;
+        
+        dense.removeEdge(999, 199);
+        std::cout << (!dense.hasEdge(999, 199) ? "✓" : "❌") << " Removed edge no longer indexed" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
+void testDeepTraversal() {
+    std::cout << "\n=== Test 8: Deep Traversal (10000-vertex path) ===" << std::endl;
+    
+    try {
+        Graph path(10000, false);
+        for (int i = 0; i < 9999; ++i) {
+            path.addEdge(i, i + 1);
+        }
+        path.freeze();
+        std::cout << (path.isConnected() ? "✓" : "❌") << " Path graph connected (iterative DFS)" << std::endl;
+        
+        path.removeEdge(4999, 5000);
+        std::cout << (!path.isConnected() ? "✓" : "❌") << " Split path detected as disconnected" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
+void testWeightedEdges() {
+    std::cout << "\n=== Test 9: Weighted Edges ===" << std::endl;
+    
+    try {
+        Graph g(4, false);
+        g.addEdge(0, 1, 5);
+        g.addEdge(1, 2, 7);
+        g.addEdge(2, 3, 9);
+        g.addEdge(0, 3);
+        
+        bool basicOk = g.isWeighted() && g.getEdgeWeight(1, 0) == 5 && g.getEdgeWeight(0, 3) == 1;
+        std::cout << (basicOk ? "✓" : "❌") << " Weights stored on both directions, default weight 1" << std::endl;
+        
+        g.freeze();
+        bool alignedOk = true;
+        for (int v = 0; v < g.getVertexCount(); ++v) {
+            NeighborRange neighbors = g.neighbors(v);
+            WeightRange weights = g.neighborWeights(v);
+            alignedOk = alignedOk && neighbors.size() == weights.size();
+            for (size_t i = 0; alignedOk && i < neighbors.size(); ++i) {
+                alignedOk = weights[i] == g.getEdgeWeight(neighbors[i], v);
+            }
+        }
+        std::cout << (alignedOk ? "✓" : "❌") << " Frozen weights aligned with CSR neighbors" << std::endl;
+        
+        g.removeEdge(1, 2);
+        bool removeOk = !g.hasEdge(2, 1) && g.getEdgeWeight(2, 3) == 9 && g.getEdgeWeight(1, 0) == 5;
+        std::cout << (removeOk ? "✓" : "❌") << " removeEdge keeps remaining weights aligned" << std::endl;
+        
+        try {
+            g.getEdgeWeight(1, 3);
+            std::cout << "❌ Missing edge weight was not rejected" << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "✓ Missing edge weight rejected: " << e.what() << std::endl;
+        }
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
+void testGraphSignature() {
+    std::cout << "\n=== Test 10: Graph Signature ===" << std::endl;
+    
+    try {
+        Graph a(4, false);
+        a.addEdge(0, 1, 3);
+        a.addEdge(1, 2);
+        a.addEdge(2, 3, 5);
+        
+        Graph b(4, false);
+        b.addEdge(3, 2, 5);
+        b.addEdge(1, 0, 3);
+        b.addEdge(2, 1);
+        b.freeze();
+        
+        GraphSignature sa = GraphSignature::of(a);
+        GraphSignature sb = GraphSignature::of(b);
+        bool orderOk = sa.hash == sb.hash && sa.canonical == sb.canonical;
+        std::cout << (orderOk ? "✓" : "❌") << " Edge order and freezing do not change the signature" << std::endl;
+        
+        Graph reweighted(4, false);
+        reweighted.addEdge(0, 1, 4);
+        reweighted.addEdge(1, 2);
+        reweighted.addEdge(2, 3, 5);
+        Graph larger(5, false);
+        larger.addEdge(0, 1, 3);
+        larger.addEdge(1, 2);
+        larger.addEdge(2, 3, 5);
+        Graph directed(4, true);
+        directed.addEdge(0, 1, 3);
+        directed.addEdge(1, 2);
+        directed.addEdge(2, 3, 5);
+        
+        bool distinctOk = GraphSignature::of(reweighted).canonical != sa.canonical &&
+                          GraphSignature::of(larger).canonical != sa.canonical &&
+                          GraphSignature::of(directed).canonical != sa.canonical;
+        std::cout << (distinctOk ? "✓" : "❌") << " Weights, vertex count and direction are part of the signature" << std::endl;
+        
+        Graph reversed(4, true);
+        reversed.addEdge(1, 0, 3);
+        reversed.addEdge(2, 1);
+        reversed.addEdge(3, 2, 5);
+        bool reversedOk = GraphSignature::of(reversed).canonical != GraphSignature::of(directed).canonical;
+        std::cout << (reversedOk ? "✓" : "❌") << " Directed edges keep their orientation" << std::endl;
+        
+        // Path 0-1-2-3 relabelled as 2-0-3-1: same shape, different labels
+        Graph path(4, false);
+        path.addEdge(0, 1, 3);
+        path.addEdge(1, 2);
+        path.addEdge(2, 3, 5);
+        Graph relabelled(4, false);
+        relabelled.addEdge(2, 0, 3);
+        relabelled.addEdge(0, 3);
+        relabelled.addEdge(3, 1, 5);
+        GraphSignature cp, cr;
+        bool canonicalOk = GraphSignature::canonicalOf(path, cp) && GraphSignature::canonicalOf(relabelled, cr) &&
+                           cp.canonical == cr.canonical &&
+                           GraphSignature::of(path).canonical != GraphSignature::of(relabelled).canonical &&
+                           GraphSignature::fingerprint(path) == GraphSignature::fingerprint(relabelled);
+        std::cout << (canonicalOk ? "✓" : "❌") << " Relabelled copy shares canonical form and fingerprint" << std::endl;
+        
+        // K3,3 and the triangular prism are both 3-regular on 6 vertices:
+        // colour refinement cannot split them, canonical labelling can
+        Graph bipartite(6, false);
+        Graph prism(6, false);
+        for (int u = 0; u < 3; ++u) {
+            for (int v = 3; v < 6; ++v) bipartite.addEdge(u, v);
+            prism.addEdge(u, (u + 1) % 3);
+            prism.addEdge(u + 3, (u + 1) % 3 + 3);
+            prism.addEdge(u, u + 3);
+        }
+        GraphSignature cb, cq;
+        bool regularOk = GraphSignature::fingerprint(bipartite) == GraphSignature::fingerprint(prism) &&
+                         GraphSignature::canonicalOf(bipartite, cb) && GraphSignature::canonicalOf(prism, cq) &&
+                         cb.canonical != cq.canonical;
+        std::cout << (regularOk ? "✓" : "❌") << " Canonical form separates graphs the fingerprint cannot" << std::endl;
+        
+        // Highly symmetric graphs still canonicalize within budget
+        Graph complete(40, false);
+        for (int u = 0; u < 40; ++u) {
+            for (int v = u + 1; v < 40; ++v) complete.addEdge(u, v);
+        }
+        GraphSignature ck;
+        bool symmetricOk = GraphSignature::canonicalOf(complete, ck);
+        std::cout << (symmetricOk ? "✓" : "❌") << " Complete graph K40 canonicalized" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
+// Messages compare equal field by field, batch graphs included
+bool sameMessage(const StreamMessage& a, const StreamMessage& b) {
+    if (a.kind != b.kind || a.text != b.text || a.vertices != b.vertices || a.edgeCount != b.edgeCount ||
+        a.algorithmMask != b.algorithmMask || a.error != b.error || a.edges.size() != b.edges.size() ||
+        a.graphs.size() != b.graphs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.edges.size(); ++i) {
+        if (a.edges[i].u != b.edges[i].u || a.edges[i].v != b.edges[i].v || a.edges[i].weight != b.edges[i].weight) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a.graphs.size(); ++i) {
+        if (!sameMessage(a.graphs[i], b.graphs[i])) return false;
+    }
+    return true;
+}
+
+// Feeds the input in pieces of at most 'chunk' bytes and collects the messages
+std::vector<StreamMessage> streamMessages(const std::string& input, size_t chunk,
+                                          RequestStream::GraphLines graphLines, bool* failed = nullptr) {
+    RequestStream stream(graphLines);
+    std::vector<StreamMessage> messages;
+    StreamMessage message;
+    for (size_t offset = 0; offset < input.size(); offset += chunk) {
+        stream.append(input.data() + offset, std::min(chunk, input.size() - offset));
+        while (stream.next(message)) {
+            messages.push_back(std::move(message));
+            message = StreamMessage();
+        }
+    }
+    if (failed) *failed = stream.failed();
+    return messages;
+}
+
+void testRequestStream() {
+    std::cout << "\n=== Test 11: Request Stream ===" << std::endl;
+    
+    try {
+        // A long graph line, so the ring wraps and the tokenizer's block path runs
+        std::string longLine = "300 2000";
+        for (int i = 0; i < 2000; ++i) {
+            longLine += " " + std::to_string(i % 300) + "-" + std::to_string((i * 7 + 1) % 300) + ":" +
+                        std::to_string(i % 13);
+        }
+        std::vector<EdgeToken> frameEdges = {{0, 1, 1}, {1, 2, 1}, {2, 0, 1}};
+        BinaryRequest first, second;
+        first.vertexCount = 3;
+        first.edges = {{0, 1, 4}, {1, 2, -2}};
+        second.vertexCount = 2;
+        second.edges = {{0, 1, 9}};
+        
+        std::string input = "help\n"
+                            "stats\r\n"
+                            "3 3 0-1 1-2 2-0\n"
+                            "4 2 0-1:5\t 2-3:-7\r\n" +
+                            longLine + "\n"
+                            "3 2 0-1 x-y 1-2\n"
+                            "mst,scc 3 2 0-1 1-2\n" +
+                            BinaryProtocol::encodeRequest(3, frameEdges, 0x11) +
+                            "3 oops\n" +
+                            BinaryProtocol::encodeBatch({first, second, BinaryRequest()}, 0x04, true) +
+                            "quit\n";
+        
+        std::vector<StreamMessage> whole = streamMessages(input, input.size(),
+                                                          RequestStream::GraphLines::OPTIONAL_COMMAND_COUNTS);
+        bool wholeOk = whole.size() == 11 &&
+                       whole[0].kind == StreamMessage::Kind::LINE && whole[0].text == "help" &&
+                       whole[1].text == "stats" &&
+                       whole[2].kind == StreamMessage::Kind::GRAPH && whole[2].edges.size() == 3 &&
+                       whole[3].edges.size() == 2 && whole[3].edges[1].weight == -7 &&
+                       whole[4].edges.size() == 2000 && whole[4].edges[1999].weight == 1999 % 13 &&
+                       !whole[5].error.empty() &&
+                       whole[6].text == "mst,scc" && whole[6].vertices == 3 &&
+                       whole[7].kind == StreamMessage::Kind::FRAME && whole[7].algorithmMask == 0x11 &&
+                       whole[8].kind == StreamMessage::Kind::LINE && whole[8].text == "3 oops" &&
+                       whole[9].kind == StreamMessage::Kind::BATCH && whole[9].graphs.size() == 3 &&
+                       whole[9].graphs[0].edges[1].weight == -2 && whole[9].graphs[1].edges[0].weight == 9 &&
+                       whole[9].graphs[2].edges.empty() &&
+                       whole[10].text == "quit";
+        std::cout << (wholeOk ? "✓" : "❌") << " Lines, graph lines, frames and batches parsed in one read" << std::endl;
+        
+        bool splitOk = true;
+        for (size_t chunk : {1, 2, 7, 16, 4095}) {
+            std::vector<StreamMessage> split = streamMessages(input, chunk,
+                                                              RequestStream::GraphLines::OPTIONAL_COMMAND_COUNTS);
+            splitOk = splitOk && split.size() == whole.size();
+            for (size_t i = 0; splitOk && i < split.size(); ++i) {
+                splitOk = sameMessage(split[i], whole[i]);
+            }
+        }
+        std::cout << (splitOk ? "✓" : "❌") << " Same messages when fed 1, 2, 7, 16 and 4095 bytes at a time" << std::endl;
+        
+        std::vector<StreamMessage> counts = streamMessages(input, 1, RequestStream::GraphLines::COUNTS);
+        std::vector<StreamMessage> none = streamMessages(input, 3, RequestStream::GraphLines::NONE);
+        bool modesOk = counts.size() == 11 && counts[6].kind == StreamMessage::Kind::LINE &&
+                       counts[6].text == "mst,scc 3 2 0-1 1-2" && counts[2].kind == StreamMessage::Kind::GRAPH &&
+                       none.size() == 11 && none[2].kind == StreamMessage::Kind::LINE &&
+                       none[2].text == "3 3 0-1 1-2 2-0" && none[7].kind == StreamMessage::Kind::FRAME;
+        std::cout << (modesOk ? "✓" : "❌") << " Graph line modes decide which lines are parsed as graphs" << std::endl;
+        
+        RequestStream shortLines(RequestStream::GraphLines::NONE, 16);
+        std::string overlong = "ok\n" + std::string(40, 'a') + "\nnever\n";
+        for (char c : overlong) shortLines.append(&c, 1);
+        StreamMessage message;
+        bool overlongOk = shortLines.next(message) && message.text == "ok" && !shortLines.next(message) &&
+                          shortLines.failed() && !shortLines.failedInFrame();
+        std::cout << (overlongOk ? "✓" : "❌") << " Over-long line fails the stream after earlier messages" << std::endl;
+        
+        std::string batch = BinaryProtocol::encodeBatch({first}, 0x01, true);
+        batch[12] = static_cast<char>(batch[12] + 4);      // body length 4 bytes too long
+        bool failed = false;
+        std::vector<StreamMessage> broken = streamMessages(batch + std::string(4, 'x') + "help\n", 1,
+                                                           RequestStream::GraphLines::COUNTS, &failed);
+        RequestStream badVersion(RequestStream::GraphLines::COUNTS);
+        std::string frame = BinaryProtocol::encodeRequest(3, frameEdges, 0x01);
+        frame[4] = 9;
+        badVersion.append(frame.data(), frame.size());
+        bool frameFailOk = broken.empty() && failed && badVersion.failed() && badVersion.failedInFrame();
+        std::cout << (frameFailOk ? "✓" : "❌") << " Batch length mismatch and bad frame version fail the stream" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
+void testEdgeTokenizer() {
+    std::cout << "\n=== Test 12: Edge Tokenizer ===" << std::endl;
+    
+    try {
+        // Every token the tokenizer accepts must parse the same way with
+        // parseEdgeToken(); the ones it declines are left to parseEdgeToken()
+        std::vector<std::string> tokens = {"0-1", "12-345:6", "999999999-1", "1000000000-1", "007-08:09",
+                                           "1-2:", "-1-2", "1--2", "1-2:3:4", "+1-2", "1-+2", "a-b", "1-2x",
+                                           "2147483647-0", "1-2:-3", "5-5", "1-2:999999999"};
+        std::mt19937 random(7);
+        const std::string alphabet = "0123456789--::+x";
+        for (int i = 0; i < 20000; ++i) {
+            std::string token;
+            int length = 1 + random() % 24;
+            for (int j = 0; j < length; ++j) token += alphabet[random() % alphabet.size()];
+            tokens.push_back(token);
+        }
+        
+        int accepted = 0;
+        bool agreeOk = true;
+        for (const std::string& token : tokens) {
+            // Short and long trailing padding: the scalar path and the 16-byte block path
+            for (const std::string& padding : {std::string(" "), std::string(20, ' ')}) {
+                std::string buffer = token + padding;
+                EdgeToken edge;
+                EdgeTokenizer::Scan scan = EdgeTokenizer::scan(buffer.data(), buffer.size(), &edge, 1);
+                if (scan.edges == 0) {
+                    agreeOk = agreeOk && scan.consumed == 0;
+                    continue;
+                }
+                accepted++;
+                try {
+                    EdgeToken expected = parseEdgeToken(token);
+                    agreeOk = agreeOk && scan.consumed == token.size() && expected.u == edge.u &&
+                              expected.v == edge.v && expected.weight == edge.weight;
+                } catch (const std::exception&) {
+                    agreeOk = false;
+                }
+            }
+        }
+        std::cout << (agreeOk ? "✓" : "❌") << " Tokenizer agrees with parseEdgeToken on " << tokens.size()
+                  << " tokens (" << accepted << " accepted)" << std::endl;
+        
+        std::string line = "0-1 2-3:4\t5-6\r\n7-8";
+        EdgeToken edges[8];
+        EdgeTokenizer::Scan scan = EdgeTokenizer::scan(line.data(), line.size(), edges, 8);
+        bool lineOk = scan.edges == 3 && scan.lineEnded && scan.consumed == line.size() - 3 &&
+                      edges[1].weight == 4 && edges[2].u == 5;
+        EdgeTokenizer::Scan full = EdgeTokenizer::scan(line.data(), line.size(), edges, 2);
+        EdgeTokenizer::Scan open = EdgeTokenizer::scan(line.data() + scan.consumed, 3, edges, 8);
+        bool stopOk = full.edges == 2 && !full.lineEnded && open.edges == 0 && open.consumed == 0;
+        std::cout << (lineOk && stopOk ? "✓" : "❌")
+                  << " Stops at the line end, a full output and an unfinished token" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
+void testBinaryProtocol() {
+    std::cout << "\n=== Test 13: Binary Protocol ===" << std::endl;
+    
+    try {
+        std::vector<EdgeToken> edges = {{0, 1, 3}, {1, 2, -4}};
+        std::string frame = BinaryProtocol::encodeRequest(3, edges, 0x05, true);
+        BinaryRequest request = BinaryProtocol::decodeRequest(frame.data(), frame.size());
+        bool roundTripOk = BinaryProtocol::frameLength(frame.data(), frame.size()) == frame.size() &&
+                           BinaryProtocol::frameLength(frame.data(), frame.size() - 1) == 0 &&
+                           request.vertexCount == 3 && request.algorithmMask == 0x05 &&
+                           request.edges.size() == 2 && request.edges[1].weight == -4;
+        std::cout << (roundTripOk ? "✓" : "❌") << " GBIN frame round trip" << std::endl;
+        
+        auto rejects = [](const std::string& data, bool batch) {
+            try {
+                if (batch) {
+                    BinaryProtocol::decodeBatchHeader(data.data());
+                } else {
+                    BinaryProtocol::decodeHeader(data.data());
+                }
+                return false;
+            } catch (const std::invalid_argument&) {
+                return true;
+            }
+        };
+        std::string badVersion = frame, badFlags = frame, oversized = frame, badVertices = frame;
+        badVersion[4] = 2;
+        badFlags[5] = 0x02;
+        oversized[12] = oversized[13] = oversized[14] = 0x7f;       // edge count ~ 2^31
+        badVertices[11] = static_cast<char>(0x80);                   // vertex count >= 2^31
+        bool headerOk = rejects(badVersion, false) && rejects(badFlags, false) && rejects(oversized, false) &&
+                        rejects(badVertices, false) && rejects("GBAT" + frame.substr(4), false);
+        std::cout << (headerOk ? "✓" : "❌") << " Malformed GBIN headers rejected" << std::endl;
+        
+        BinaryRequest graph;
+        graph.vertexCount = 2;
+        graph.edges = {{0, 1, 1}};
+        std::string batch = BinaryProtocol::encodeBatch({graph, graph}, 0x01);
+        BatchHeader header = BinaryProtocol::decodeBatchHeader(batch.data());
+        bool batchOk = BinaryProtocol::isFrameStart(batch.data(), 2) && BinaryProtocol::isBatch(batch.data()) &&
+                       header.graphCount == 2 && header.bodyLength == batch.size() - BinaryProtocol::BATCH_HEADER_SIZE &&
+                       !BinaryProtocol::isFrameStart("GRES", 4);
+        
+        std::string tooMany = batch, tooShort = batch, batchVersion = batch, batchFlags = batch;
+        tooMany[10] = 0x02;                                           // 2^17 graphs
+        tooShort[8] = 0x7f;                                           // 127 graphs in 32 bytes
+        batchVersion[4] = 0;
+        batchFlags[5] = static_cast<char>(0x80);
+        std::string hugeBody = batch;
+        hugeBody[15] = 0x7f;
+        bool batchHeaderOk = rejects(tooMany, true) && rejects(tooShort, true) && rejects(batchVersion, true) &&
+                             rejects(batchFlags, true) && rejects(hugeBody, true) && rejects(frame, true);
+        std::cout << (batchOk ? "✓" : "❌") << " GBAT batch header decoded" << std::endl;
+        std::cout << (batchHeaderOk ? "✓" : "❌") << " Malformed GBAT headers rejected" << std::endl;
+        
+        try {
+            FrameHeader small = BinaryProtocol::decodeHeader(frame.data());
+            std::string record = frame.substr(BinaryProtocol::REQUEST_HEADER_SIZE, 12);
+            record[4] = 3;                                            // v = 3 in a 3-vertex graph
+            BinaryProtocol::decodeEdge(record.data(), small);
+            std::cout << "❌ Out-of-range edge was not rejected" << std::endl;
+        } catch (const std::invalid_argument& e) {
+            std::cout << "✓ Out-of-range edge rejected: " << e.what() << std::endl;
+        }
+        
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+    }
+}
+
 int main() {
     std::cout << "=== Q1: Graph Data Structure Implementation Testing ===" << std::endl;
     std::cout << "Testing comprehensive Graph class functionality..." << std::endl;
@@ -218,6 +721,14 @@ int main() {
     testErrorHandling();
     testSpecialGraphs();
     testCopyAndModify();
+    testFrozenGraph();
+    testEdgeIndex();
+    testDeepTraversal();
+    testWeightedEdges();
+    testGraphSignature();
+    testRequestStream();
+    testEdgeTokenizer();
+    testBinaryProtocol();
     
     std::cout << "\n=== Q1 Testing Completed Successfully! ===" << std::endl;
     std::cout << "✓ Graph data structure is working correctly" << std::endl;
@@ -104,8 +104,7 @@ void analyzeEulerProperties(const Graph& graph, bool verbose) {
     
     if (hasEuler) {
         std::cout << "Finding Euler circuit..." << std::endl;
-        Graph workingGraph = graph; // Copy for modification
-        auto circuit = workingGraph.findEulerCircuit();
+        auto circuit = graph.findEulerCircuit();
         
         if (!circuit.empty()) {
             std::cout << "✓ Euler circuit found!" << std::endl;
@@ -263,6 +262,7 @@ int main(int argc, char* argv[]) {
         // Generate the graph
         if (!quiet) std::cout << "\n=== Graph Generation ===" << std::endl;
         auto graph = GraphGenerator::generateRandomGraph(vertices, edges, seed, directed);
+        graph->freeze();
         
         if (!quiet) {
             std::cout << "✓ Random graph generated successfully!" << std::endl;
@@ -8,7 +8,7 @@ mkdir -p ../reports/coverage
 echo "Compiling with coverage instrumentation..."
 g++ -Wall -Wextra -std=c++17 -g -O0 --coverage -fprofile-arcs -ftest-coverage \
     -I../common \
-    main.cpp ../common/Graph.cpp ../common/GraphGenerator.cpp \
+    main.cpp ../common/Graph.cpp ../common/EdgeIndex.cpp ../common/EulerEngine.cpp ../common/GraphGenerator.cpp \
     -o ../bin/q4_coverage_test
 
 if [ $? -ne 0 ]; then
@@ -56,7 +56,7 @@ echo ""
 echo "Generating coverage reports..."
 
 # Generate coverage report with gcov
-gcov -b -c main.cpp Graph.cpp GraphGenerator.cpp 2>/dev/null
+gcov -b -c main.cpp Graph.cpp EdgeIndex.cpp EulerEngine.cpp GraphGenerator.cpp 2>/dev/null
 
 # Move coverage files to reports directory
 mv *.gcov ../reports/coverage/ 2>/dev/null || true
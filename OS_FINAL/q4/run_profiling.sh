@@ -8,7 +8,7 @@ mkdir -p ../reports/profiling
 echo "Compiling with profiling instrumentation..."
 g++ -Wall -Wextra -std=c++17 -g -O0 -pg \
     -I../common \
-    main.cpp ../common/Graph.cpp ../common/GraphGenerator.cpp \
+    main.cpp ../common/Graph.cpp ../common/EdgeIndex.cpp ../common/EulerEngine.cpp ../common/GraphGenerator.cpp \
     -o ../bin/q4_profiling_test
 
 if [ $? -ne 0 ]; then
@@ -108,7 +108,7 @@ TARGET_VALGRIND = $(BIN_DIR)/q4_valgrind_test
 TARGET_PROFILING = $(BIN_DIR)/q4_profiling_test
 
 # Source files (reuse Q3's main.cpp)
-SOURCES = main.cpp $(COMMON_DIR)/Graph.cpp $(COMMON_DIR)/GraphGenerator.cpp
+SOURCES = main.cpp $(COMMON_DIR)/Graph.cpp $(COMMON_DIR)/EdgeIndex.cpp $(COMMON_DIR)/EulerEngine.cpp $(COMMON_DIR)/GraphGenerator.cpp
 
 # Create directories
 $(shell mkdir -p $(OBJ_DIR) $(BIN_DIR) $(REPORTS_DIR)/coverage $(REPORTS_DIR)/valgrind $(REPORTS_DIR)/profiling)
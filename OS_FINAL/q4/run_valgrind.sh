@@ -16,7 +16,7 @@ fi
 echo "Compiling with debug symbols..."
 g++ -Wall -Wextra -std=c++17 -g -O0 \
     -I../common \
-    main.cpp ../common/Graph.cpp ../common/GraphGenerator.cpp \
+    main.cpp ../common/Graph.cpp ../common/EdgeIndex.cpp ../common/EulerEngine.cpp ../common/GraphGenerator.cpp \
     -o ../bin/q4_valgrind_test
 
 if [ $? -ne 0 ]; then
@@ -69,8 +69,11 @@ public:
         while (connected) {
             std::getline(std::cin, input);
             
+            // The server frames requests by newline
+            std::string line = input + "\n";
+            
             if (input == "quit" || input == "exit") {
-                send(socket_fd, input.c_str(), input.length(), 0);
+                send(socket_fd, line.c_str(), line.length(), 0);
                 break;
             }
             
@@ -85,7 +88,7 @@ public:
             }
             
             // Send to server
-            send(socket_fd, input.c_str(), input.length(), 0);
+            send(socket_fd, line.c_str(), line.length(), 0);
             
             // Get response
             memset(buffer, 0, sizeof(buffer));
@@ -1,178 +1,77 @@
 #include "../common/Graph.h"
+#include "../common/EdgeToken.h"
+#include "../servers/BaseServer.h"
 #include <iostream>
 #include <sstream>
 #include <string>
-#include <sys/socket.h>
-#include <netinet/in.h>
-#include <arpa/inet.h>
-#include <unistd.h>
-#include <cstring>
 #include <thread>
-#include <atomic>
-#include <mutex>
 #include <chrono>
 #include <csignal>
+#include <functional>
 
-class SimpleEulerServer {
-private:
-    int port;
-    std::atomic<bool> running;
-    int serverSocket;
-    std::thread serverThread;
-    std::mutex logMutex;
-    int clientCounter;
-    
+class SimpleEulerServer : public BaseServer {
 public:
-    SimpleEulerServer(int p) : port(p), running(false), serverSocket(-1), clientCounter(0) {}
+    SimpleEulerServer(int p, IoBackend backend = IoBackend::AUTO)
+        : BaseServer(p, "Euler Server", backend) {}
     
     ~SimpleEulerServer() {
         stop();
     }
     
-    void start() {
-        // Create socket
-        serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-        if (serverSocket < 0) {
-            throw std::runtime_error("Failed to create socket");
-        }
-        
-        // Allow reuse of address
-        int opt = 1;
-        setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-        
-        // Setup server address
-        struct sockaddr_in address;
-        address.sin_family = AF_INET;
-        address.sin_addr.s_addr = INADDR_ANY;
-        address.sin_port = htons(port);
-        
-        // Bind and listen
-        if (bind(serverSocket, (struct sockaddr*)&address, sizeof(address)) < 0) {
-            close(serverSocket);
-            throw std::runtime_error("Failed to bind to port " + std::to_string(port));
-        }
-        
-        if (listen(serverSocket, 5) < 0) {
-            close(serverSocket);
-            throw std::runtime_error("Failed to listen on socket");
-        }
-        
-        running = true;
-        log("=== Euler Server Started ===");
-        log("Port: " + std::to_string(port));
+protected:
+    void onStart() override {
         log("Waiting for connections...");
-        
-        // Start accepting connections
-        serverThread = std::thread(&SimpleEulerServer::acceptLoop, this);
     }
     
-    void stop() {
-        if (!running) return;
+    std::string welcomeMessage(int clientId) override {
+        return
+            "=== Euler Circuit Server ===\n"
+            "Client ID: " + std::to_string(clientId) + "\n"
+            "Format: vertices edges edge1 edge2 ...\n"
+            "Edge format: u-v or u-v:w (example: 0-1)\n"
+            "\n"
+            "Examples:\n"
+            "  Triangle: 3 3 0-1 1-2 2-0\n"
+            "  Square:   4 4 0-1 1-2 2-3 3-0\n"
+            "  Path:     3 2 0-1 1-2\n"
+            "\n"
+            "Commands: help, quit\n"
+            "> ";
+    }
+    
+    std::string handleLine(int clientId, const std::string& input, bool& closeAfterReply) override {
+        log("Client " + std::to_string(clientId) + ": " + input);
         
-        running = false;
-        if (serverSocket >= 0) {
-            close(serverSocket);
-            serverSocket = -1;
+        if (input == "quit" || input == "exit") {
+            closeAfterReply = true;
+            return "Goodbye!\n";
+        } else if (input == "help") {
+            return welcomeMessage(clientId);
+        } else if (input.empty()) {
+            return "Empty input. Type 'help' for usage.\n> ";
         }
-        if (serverThread.joinable()) {
-            serverThread.join();
-        }
-        log("=== Server Stopped ===");
+        
+        // Lines that do not start with valid counts end up here
+        return processGraph([&]() { return parseGraph(input); }, clientId) + "\n> ";
     }
     
-    bool isRunning() const {
-        return running;
+    // Graph lines are parsed edge by edge while they arrive
+    RequestStream::GraphLines graphLines() const override {
+        return RequestStream::GraphLines::COUNTS;
     }
     
-private:
-    void acceptLoop() {
-        while (running) {
-            struct sockaddr_in clientAddr;
-            socklen_t clientLen = sizeof(clientAddr);
-            
-            int clientSocket = accept(serverSocket, (struct sockaddr*)&clientAddr, &clientLen);
-            if (clientSocket < 0) {
-                if (running) {
-                    log("Failed to accept client");
-                }
-                continue;
-            }
-            
-            int clientId = ++clientCounter;
-            std::string clientIP = inet_ntoa(clientAddr.sin_addr);
-            log("Client " + std::to_string(clientId) + " connected from " + clientIP);
-            
-            // Handle client in separate thread
-            std::thread clientThread(&SimpleEulerServer::handleClient, this, clientSocket, clientId);
-            clientThread.detach();
-        }
-    }
-    
-    void handleClient(int clientSocket, int clientId) {
-        try {
-            // Send welcome message
-            std::string welcome = 
-                "=== Euler Circuit Server ===\n"
-                "Client ID: " + std::to_string(clientId) + "\n"
-                "Format: vertices edges edge1 edge2 ...\n"
-                "Edge format: u-v (example: 0-1)\n"
-                "\n"
-                "Examples:\n"
-                "  Triangle: 3 3 0-1 1-2 2-0\n"
-                "  Square:   4 4 0-1 1-2 2-3 3-0\n"
-                "  Path:     3 2 0-1 1-2\n"
-                "\n"
-                "Commands: help, quit\n"
-                "> ";
-            
-            send(clientSocket, welcome.c_str(), welcome.length(), 0);
-            
-            char buffer[1024];
-            while (running) {
-                memset(buffer, 0, sizeof(buffer));
-                int bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-                
-                if (bytesRead <= 0) {
-                    log("Client " + std::to_string(clientId) + " disconnected");
-                    break;
-                }
-                
-                std::string input(buffer);
-                input.erase(input.find_last_not_of("\r\n") + 1); // Remove newlines
-                
-                log("Client " + std::to_string(clientId) + ": " + input);
-                
-                std::string response;
-                
-                if (input == "quit" || input == "exit") {
-                    response = "Goodbye!\n";
-                    send(clientSocket, response.c_str(), response.length(), 0);
-                    break;
-                } else if (input == "help") {
-                    response = welcome;
-                } else if (input.empty()) {
-                    response = "Empty input. Type 'help' for usage.\n> ";
-                } else {
-                    // Process graph
-                    response = processGraph(input, clientId) + "\n> ";
-                }
-                
-                send(clientSocket, response.c_str(), response.length(), 0);
-            }
-            
-        } catch (const std::exception& e) {
-            log("Client " + std::to_string(clientId) + " error: " + std::string(e.what()));
-        }
-        
-        close(clientSocket);
+    std::string handleGraph(int clientId, const StreamMessage& request, bool&) override {
+        log("Client " + std::to_string(clientId) + ": graph, " + std::to_string(request.vertices) + " vertices, " +
+            std::to_string(request.edgeCount) + " edges");
+        return processGraph([&]() { return buildGraph(request); }, clientId) + "\n> ";
     }
     
-    std::string processGraph(const std::string& input, int clientId) {
+private:
+    std::string processGraph(const std::function<Graph()>& makeGraph, int clientId) {
         try {
             auto start = std::chrono::high_resolution_clock::now();
             
-            // Parse graph
-            Graph graph = parseGraph(input);
+            Graph graph = makeGraph();
             
             // Analyze Euler circuit
             bool hasEuler = graph.hasEulerCircuit();
@@ -187,8 +86,7 @@ private:
             if (hasEuler) {
                 result << "Euler Circuit: ✓ EXISTS\n";
                 
-                Graph workingGraph = graph;
-                auto circuit = workingGraph.findEulerCircuit();
+                auto circuit = graph.findEulerCircuit();
                 
                 if (!circuit.empty()) {
                     result << "Circuit: ";
@@ -237,14 +135,7 @@ private:
             throw std::invalid_argument("Missing or invalid edges count");
         }
         
-        // Validate
-        if (vertices <= 0 || vertices > 100) {
-            throw std::invalid_argument("Vertices must be 1-100, got: " + std::to_string(vertices));
-        }
-        if (edges < 0 || edges > vertices * (vertices - 1) / 2) {
-            throw std::invalid_argument("Invalid edges count: " + std::to_string(edges));
-        }
-        
+        validateCounts(vertices, edges);
         Graph graph(vertices, false);
         
         // Parse edges
@@ -252,30 +143,17 @@ private:
         int edgeCount = 0;
         
         while (iss >> edgeStr && edgeCount < edges) {
-            size_t dashPos = edgeStr.find('-');
-            if (dashPos == std::string::npos) {
-                throw std::invalid_argument("Invalid edge format: " + edgeStr + " (expected: u-v)");
-            }
+            EdgeToken edge = parseEdgeToken(edgeStr);
             
-            try {
-                int u = std::stoi(edgeStr.substr(0, dashPos));
-                int v = std::stoi(edgeStr.substr(dashPos + 1));
-                
-                if (u < 0 || u >= vertices || v < 0 || v >= vertices) {
-                    throw std::invalid_argument("Vertex out of range: " + edgeStr);
-                }
-                if (u == v) {
-                    throw std::invalid_argument("Self-loops not allowed: " + edgeStr);
-                }
-                
-                graph.addEdge(u, v);
-                edgeCount++;
-                
-            } catch (const std::invalid_argument& e) {
-                throw;
-            } catch (const std::exception& e) {
-                throw std::invalid_argument("Invalid edge: " + edgeStr);
+            if (edge.u < 0 || edge.u >= vertices || edge.v < 0 || edge.v >= vertices) {
+                throw std::invalid_argument("Vertex out of range: " + edgeStr);
+            }
+            if (edge.u == edge.v) {
+                throw std::invalid_argument("Self-loops not allowed: " + edgeStr);
             }
+            
+            graph.addEdge(edge.u, edge.v, edge.weight);
+            edgeCount++;
         }
         
         if (edgeCount != edges) {
@@ -283,19 +161,44 @@ private:
                                       " edges, got " + std::to_string(edgeCount));
         }
         
+        graph.freeze();
         return graph;
     }
     
-    void log(const std::string& message) {
-        std::lock_guard<std::mutex> lock(logMutex);
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto tm = *std::localtime(&time_t);
+    // Same checks, in the same order, as parseGraph on an already tokenized request
+    Graph buildGraph(const StreamMessage& request) {
+        validateCounts(request.vertices, request.edgeCount);
+        Graph graph(request.vertices, false);
         
-        char timeStr[20];
-        strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &tm);
+        for (const auto& edge : request.edges) {
+            if (edge.u < 0 || edge.u >= request.vertices || edge.v < 0 || edge.v >= request.vertices) {
+                throw std::invalid_argument("Vertex out of range: " + edgeTokenToString(edge));
+            }
+            if (edge.u == edge.v) {
+                throw std::invalid_argument("Self-loops not allowed: " + edgeTokenToString(edge));
+            }
+            graph.addEdge(edge.u, edge.v, edge.weight);
+        }
+        if (!request.error.empty()) {
+            throw std::invalid_argument(request.error);
+        }
         
-        std::cout << "[" << timeStr << "] " << message << std::endl;
+        if (static_cast<int>(request.edges.size()) != request.edgeCount) {
+            throw std::invalid_argument("Expected " + std::to_string(request.edgeCount) + 
+                                      " edges, got " + std::to_string(request.edges.size()));
+        }
+        
+        graph.freeze();
+        return graph;
+    }
+    
+    void validateCounts(int vertices, int edges) {
+        if (vertices <= 0 || vertices > 100) {
+            throw std::invalid_argument("Vertices must be 1-100, got: " + std::to_string(vertices));
+        }
+        if (edges < 0 || edges > vertices * (vertices - 1) / 2) {
+            throw std::invalid_argument("Invalid edges count: " + std::to_string(edges));
+        }
     }
 };
 
@@ -311,14 +214,24 @@ void signalHandler(int signal) {
 
 int main(int argc, char* argv[]) {
     int port = 8080;
+    IoBackend backend = IoBackend::AUTO;
     
     // Parse arguments
-    if (argc > 2) {
-        std::cerr << "Usage: " << argv[0] << " [port]" << std::endl;
+    if (argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " [port] [auto|io_uring|epoll]" << std::endl;
         return 1;
     }
     
-    if (argc == 2) {
+    if (argc == 3) {
+        try {
+            backend = BaseServer::stringToBackend(argv[2]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (argc >= 2) {
         try {
             port = std::stoi(argv[1]);
             if (port < 1024 || port > 65535) {
@@ -336,7 +249,7 @@ int main(int argc, char* argv[]) {
         signal(SIGINT, signalHandler);
         signal(SIGTERM, signalHandler);
         
-        SimpleEulerServer server(port);
+        SimpleEulerServer server(port, backend);
         globalServer = &server;
         
         std::cout << "=== Q6: Euler Circuit Server ===" << std::endl;
@@ -69,8 +69,11 @@ public:
         while (connected) {
             std::getline(std::cin, input);
             
+            // The server frames requests by newline
+            std::string line = input + "\n";
+            
             if (input == "quit" || input == "exit") {
-                send(socket_fd, input.c_str(), input.length(), 0);
+                send(socket_fd, line.c_str(), line.length(), 0);
                 break;
             }
             
@@ -85,7 +88,7 @@ public:
             }
             
             // Send to server
-            send(socket_fd, input.c_str(), input.length(), 0);
+            send(socket_fd, line.c_str(), line.length(), 0);
             
             // Get response
             memset(buffer, 0, sizeof(buffer));
@@ -116,6 +119,7 @@ private:
         std::cout << "MST (undirected):" << std::endl;
         std::cout << "  mst 4 4 0-1 1-2 2-3 3-0" << std::endl;
         std::cout << "  mst 5 6 0-1 0-2 1-3 2-3 3-4 4-1" << std::endl;
+        std::cout << "  mst 4 5 0-1:4 1-2:2 2-3:7 3-0:1 0-2:3   (weighted u-v:w)" << std::endl;
         std::cout << std::endl;
         std::cout << "HAMILTON (any):" << std::endl;
         std::cout << "  hamilton 4 4 0-1 1-2 2-3 3-0" << std::endl;
@@ -124,6 +128,7 @@ private:
         std::cout << "SCC (directed only):" << std::endl;
         std::cout << "  scc 4 4 0-1 1-2 2-0 0-3" << std::endl;
         std::cout << "  scc 3 3 0-1 1-2 2-0" << std::endl;
+        std::cout << "  scc:kosaraju 4 4 0-1 1-2 2-0 0-3" << std::endl;
         std::cout << std::endl;
         std::cout << "Commands: algorithms, help, quit, examples" << std::endl;
         std::cout << "=======================" << std::endl;
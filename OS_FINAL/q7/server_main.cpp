@@ -1,177 +1,167 @@
 #include "../common/Graph.h"
+#include "../common/EdgeToken.h"
+#include "../common/BinaryProtocol.h"
 #include "../common/GraphGenerator.h"
 #include "../algorithms/AlgorithmFactory.h"
+#include "../algorithms/ResultCache.h"
+#include "../algorithms/AlgorithmRunner.h"
+#include "../servers/BaseServer.h"
 #include <iostream>
 #include <sstream>
 #include <string>
-#include <sys/socket.h>
-#include <netinet/in.h>
-#include <arpa/inet.h>
-#include <unistd.h>
-#include <cstring>
+#include <memory>
+#include <vector>
 #include <thread>
-#include <atomic>
-#include <mutex>
 #include <chrono>
 #include <csignal>
 
-class AlgorithmsServer {
-private:
-    int port;
-    std::atomic<bool> running;
-    int serverSocket;
-    std::thread serverThread;
-    std::mutex logMutex;
-    int clientCounter;
-    
+class AlgorithmsServer : public BaseServer {
 public:
-    AlgorithmsServer(int p) : port(p), running(false), serverSocket(-1), clientCounter(0) {}
+    // A cacheBytes of 0 disables the result cache
+    AlgorithmsServer(int p, IoBackend backend = IoBackend::AUTO,
+                     size_t cacheBytes = ResultCache::DEFAULT_BYTE_BUDGET)
+        : BaseServer(p, "Algorithms Server", backend) {
+        if (cacheBytes > 0) {
+            resultCache = std::make_unique<ResultCache>(cacheBytes);
+        }
+    }
     
     ~AlgorithmsServer() {
         stop();
     }
     
-    void start() {
-        // Create socket
-        serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-        if (serverSocket < 0) {
-            throw std::runtime_error("Failed to create socket");
-        }
-        
-        // Allow reuse
-        int opt = 1;
-        setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-        
-        // Setup address
-        struct sockaddr_in address;
-        address.sin_family = AF_INET;
-        address.sin_addr.s_addr = INADDR_ANY;
-        address.sin_port = htons(port);
-        
-        // Bind and listen
-        if (bind(serverSocket, (struct sockaddr*)&address, sizeof(address)) < 0) {
-            close(serverSocket);
-            throw std::runtime_error("Failed to bind to port " + std::to_string(port));
-        }
-        
-        if (listen(serverSocket, 5) < 0) {
-            close(serverSocket);
-            throw std::runtime_error("Failed to listen on socket");
-        }
-        
-        running = true;
-        log("=== Algorithms Server Started ===");
-        log("Port: " + std::to_string(port));
+protected:
+    void onStart() override {
         log("Supported algorithms: " + getAlgorithmsList());
         log("Graph + Algorithm requests accepted");
-        
-        // Start accepting
-        serverThread = std::thread(&AlgorithmsServer::acceptLoop, this);
+        log(resultCache ? "Result cache enabled" : "Result cache disabled");
     }
     
-    void stop() {
-        if (!running) return;
-        
-        running = false;
-        if (serverSocket >= 0) {
-            close(serverSocket);
-            serverSocket = -1;
-        }
-        if (serverThread.joinable()) {
-            serverThread.join();
+    std::string welcomeMessage(int clientId) override {
+        return
+            "=== Algorithms Server ===\n"
+            "Client ID: " + std::to_string(clientId) + "\n"
+            "Format: algorithm vertices edges edge1 edge2 ...\n"
+            "Edge format: u-v or weighted u-v:w (weights default to 1)\n"
+            "Algorithms: " + getAlgorithmsList() + "\n"
+            "\n"
+            "Examples:\n"
+            "  euler 3 3 0-1 1-2 2-0\n"
+            "  clique 4 6 0-1 0-2 0-3 1-2 1-3 2-3\n"
+            "  mst 4 4 0-1:3 1-2:1 2-3:4 3-0:2\n"
+            "  hamilton 4 4 0-1 1-2 2-3 3-0\n"
+            "  scc 3 3 0-1 1-2 2-0  (directed)\n"
+            "\n"
+            "Commands: algorithms, stats, help, quit\n"
+            "Binary GBIN frames run every algorithm in their mask\n"
+            "> ";
+    }
+    
+    std::string handleLine(int clientId, const std::string& input, bool& closeAfterReply) override {
+        log("Client " + std::to_string(clientId) + ": " + input);
+        
+        if (input == "quit" || input == "exit") {
+            closeAfterReply = true;
+            return "Goodbye!\n";
+        } else if (input == "help") {
+            return welcomeMessage(clientId);
+        } else if (input == "algorithms") {
+            return getAlgorithmsHelp() + "\n> ";
+        } else if (input == "stats") {
+            return formatStatistics() + "\n> ";
+        } else if (input.empty()) {
+            return "Empty input. Type 'help' for usage.\n> ";
         }
-        log("=== Server Stopped ===");
+        
+        // Algorithms run on the shared pool so the event loop keeps serving
+        deferReply([this, input, clientId]() {
+            return processAlgorithmRequest(input, clientId) + "\n> ";
+        });
+        return std::string();
     }
     
-    bool isRunning() const {
-        return running;
+    // "algorithm vertices edges ..." lines are parsed edge by edge while they arrive
+    RequestStream::GraphLines graphLines() const override {
+        return RequestStream::GraphLines::COMMAND_COUNTS;
+    }
+    
+    std::string handleGraph(int clientId, const StreamMessage& request, bool&) override {
+        log("Client " + std::to_string(clientId) + ": " + request.text + ", " + std::to_string(request.vertices) +
+            " vertices, " + std::to_string(request.edgeCount) + " edges");
+        deferReply([this, request, clientId]() { return processGraph(request, clientId); });
+        return std::string();
+    }
+    
+    std::string handleFrame(int clientId, const StreamMessage& request, bool&) override {
+        log("Client " + std::to_string(clientId) + ": binary frame, " + std::to_string(request.vertices) +
+            " vertices, " + std::to_string(request.edgeCount) + " edges");
+        deferReply([this, request, clientId]() { return processFrame(request, clientId); });
+        return std::string();
     }
     
 private:
-    void acceptLoop() {
-        while (running) {
-            struct sockaddr_in clientAddr;
-            socklen_t clientLen = sizeof(clientAddr);
+    std::unique_ptr<ResultCache> resultCache;   // null when caching is disabled
+    
+    std::string processGraph(const StreamMessage& request, int clientId) {
+        const std::string& algorithmName = request.text;
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
             
-            int clientSocket = accept(serverSocket, (struct sockaddr*)&clientAddr, &clientLen);
-            if (clientSocket < 0) {
-                if (running) {
-                    log("Failed to accept client");
-                }
-                continue;
+            if (!AlgorithmFactory::isValidAlgorithm(algorithmName)) {
+                return formatError("Unknown algorithm: " + algorithmName + 
+                                 ". Available: " + getAlgorithmsList()) + "\n> ";
             }
             
-            int clientId = ++clientCounter;
-            std::string clientIP = inet_ntoa(clientAddr.sin_addr);
-            log("Client " + std::to_string(clientId) + " connected from " + clientIP);
+            bool directed = (AlgorithmFactory::stringToType(algorithmName) == AlgorithmType::SCC);
+            std::unique_ptr<Graph> graph = buildGraph(request, directed);
+            AlgorithmResult result = runAlgorithm(algorithmName, *graph);
+            
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - start);
+            return formatResult(result, clientId, duration.count()) + "\n> ";
             
-            // Handle client
-            std::thread clientThread(&AlgorithmsServer::handleClient, this, clientSocket, clientId);
-            clientThread.detach();
+        } catch (const std::exception& e) {
+            return formatError(e.what()) + "\n> ";
         }
     }
     
-    void handleClient(int clientSocket, int clientId) {
+    std::string processFrame(const StreamMessage& request, int clientId) {
         try {
-            // Send welcome
-            std::string welcome = 
-                "=== Algorithms Server ===\n"
-                "Client ID: " + std::to_string(clientId) + "\n"
-                "Format: algorithm vertices edges edge1 edge2 ...\n"
-                "Algorithms: " + getAlgorithmsList() + "\n"
-                "\n"
-                "Examples:\n"
-                "  euler 3 3 0-1 1-2 2-0\n"
-                "  clique 4 6 0-1 0-2 0-3 1-2 1-3 2-3\n"
-                "  mst 4 4 0-1 1-2 2-3 3-0\n"
-                "  hamilton 4 4 0-1 1-2 2-3 3-0\n"
-                "  scc 3 3 0-1 1-2 2-0  (directed)\n"
-                "\n"
-                "Commands: algorithms, help, quit\n"
-                "> ";
+            auto start = std::chrono::high_resolution_clock::now();
+            AlgorithmRunner::Mask mask = request.algorithmMask;
+            if (mask == 0 || (mask & ~AlgorithmRunner::ALL_ALGORITHMS)) {
+                throw std::invalid_argument("Invalid algorithm mask: " + std::to_string(mask));
+            }
+            
+            // SCC gets the directed graph, the others the undirected one;
+            // each is built once, and only when some algorithm needs it
+            AlgorithmRunner::Mask sccMask = AlgorithmRunner::maskOf(AlgorithmType::SCC);
+            std::unique_ptr<Graph> undirectedGraph, directedGraph;
+            if (mask & ~sccMask) {
+                undirectedGraph = buildGraph(request, false);
+            }
+            if (mask & sccMask) {
+                directedGraph = buildGraph(request, true);
+            }
+            const Graph& undirected = undirectedGraph ? *undirectedGraph : *directedGraph;
+            const Graph& directed = directedGraph ? *directedGraph : *undirectedGraph;
             
-            send(clientSocket, welcome.c_str(), welcome.length(), 0);
+            // Already off the event loop, so the algorithms run one after another;
+            // each result carries its own execution time, the total covers the frame
+            std::vector<AlgorithmResult> results = AlgorithmRunner::runAll(
+                undirected, directed, AlgorithmRunner::Mode::SERIAL, resultCache.get(), mask);
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - start);
             
-            char buffer[2048];
-            while (running) {
-                memset(buffer, 0, sizeof(buffer));
-                int bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-                
-                if (bytesRead <= 0) {
-                    log("Client " + std::to_string(clientId) + " disconnected");
-                    break;
-                }
-                
-                std::string input(buffer);
-                input.erase(input.find_last_not_of("\r\n") + 1);
-                
-                log("Client " + std::to_string(clientId) + ": " + input);
-                
-                std::string response;
-                
-                if (input == "quit" || input == "exit") {
-                    response = "Goodbye!\n";
-                    send(clientSocket, response.c_str(), response.length(), 0);
-                    break;
-                } else if (input == "help") {
-                    response = welcome;
-                } else if (input == "algorithms") {
-                    response = getAlgorithmsHelp() + "\n> ";
-                } else if (input.empty()) {
-                    response = "Empty input. Type 'help' for usage.\n> ";
-                } else {
-                    // Process algorithm request
-                    response = processAlgorithmRequest(input, clientId) + "\n> ";
-                }
-                
-                send(clientSocket, response.c_str(), response.length(), 0);
+            std::string body;
+            for (const auto& result : results) {
+                body += formatResult(result, clientId, duration.count());
             }
+            return BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_OK, body);
             
         } catch (const std::exception& e) {
-            log("Client " + std::to_string(clientId) + " error: " + std::string(e.what()));
+            return BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR, formatError(e.what()));
         }
-        
-        close(clientSocket);
     }
     
     std::string processAlgorithmRequest(const std::string& input, int clientId) {
@@ -199,20 +189,7 @@ private:
             }
             
             Graph graph = parseGraph(graphPart, algorithmName);
-            
-            // Create and execute algorithm
-            AlgorithmType type = AlgorithmFactory::stringToType(algorithmName);
-            auto algorithm = AlgorithmFactory::createAlgorithm(type);
-            
-            // Check compatibility
-            if (graph.isDirected() && !algorithm->supportsDirected()) {
-                return formatError("Algorithm '" + algorithmName + "' doesn't support directed graphs");
-            }
-            if (!graph.isDirected() && !algorithm->supportsUndirected()) {
-                return formatError("Algorithm '" + algorithmName + "' doesn't support undirected graphs");
-            }
-            
-            auto result = algorithm->execute(graph);
+            AlgorithmResult result = runAlgorithm(algorithmName, graph);
             
             auto end = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -224,6 +201,68 @@ private:
         }
     }
     
+    AlgorithmResult runAlgorithm(const std::string& algorithmName, const Graph& graph) {
+        auto algorithm = AlgorithmFactory::createAlgorithm(algorithmName);
+        
+        // Check compatibility
+        if (graph.isDirected() && !algorithm->supportsDirected()) {
+            throw std::invalid_argument("Algorithm '" + algorithmName + "' doesn't support directed graphs");
+        }
+        if (!graph.isDirected() && !algorithm->supportsUndirected()) {
+            throw std::invalid_argument("Algorithm '" + algorithmName + "' doesn't support undirected graphs");
+        }
+        
+        // Identical graphs (in any edge order) reuse the earlier result,
+        // relabelled ones too when the answer names no vertices
+        AlgorithmResult result(AlgorithmFactory::stringToType(algorithmName));
+        ResultCache::GraphKeys keys(graph);
+        if (!resultCache || !resultCache->lookup(algorithmName, keys, result)) {
+            result = algorithm->execute(graph);
+            if (resultCache) {
+                resultCache->insert(algorithmName, keys, result);
+            }
+        }
+        return result;
+    }
+    
+    // Streamed graph lines and binary frames arrive already tokenized;
+    // same checks, in the same order, as parseGraph
+    std::unique_ptr<Graph> buildGraph(const StreamMessage& request, bool directed) {
+        validateCounts(request.vertices, request.edgeCount, directed);
+        auto graph = std::make_unique<Graph>(request.vertices, directed);
+        
+        for (const auto& edge : request.edges) {
+            if (edge.u < 0 || edge.u >= request.vertices || edge.v < 0 || edge.v >= request.vertices) {
+                throw std::invalid_argument("Vertex out of range: " + edgeTokenToString(edge));
+            }
+            if (edge.u == edge.v) {
+                throw std::invalid_argument("Self-loops not allowed: " + edgeTokenToString(edge));
+            }
+            graph->addEdge(edge.u, edge.v, edge.weight);
+        }
+        if (!request.error.empty()) {
+            throw std::invalid_argument(request.error);
+        }
+        
+        if (static_cast<int>(request.edges.size()) != request.edgeCount) {
+            throw std::invalid_argument("Expected " + std::to_string(request.edgeCount) + 
+                                      " edges, got " + std::to_string(request.edges.size()));
+        }
+        
+        graph->freeze();
+        return graph;
+    }
+    
+    void validateCounts(int vertices, int edges, bool directed) {
+        if (vertices <= 0 || vertices > 100) {
+            throw std::invalid_argument("Vertices must be 1-100, got: " + std::to_string(vertices));
+        }
+        int maxEdges = directed ? vertices * (vertices - 1) : vertices * (vertices - 1) / 2;
+        if (edges < 0 || edges > maxEdges) {
+            throw std::invalid_argument("Invalid edges count: " + std::to_string(edges));
+        }
+    }
+    
     Graph parseGraph(const std::string& input, const std::string& algorithmName) {
         std::istringstream iss(input);
         int vertices, edges;
@@ -235,18 +274,9 @@ private:
             throw std::invalid_argument("Missing or invalid edges count");
         }
         
-        // Validate
-        if (vertices <= 0 || vertices > 100) {
-            throw std::invalid_argument("Vertices must be 1-100, got: " + std::to_string(vertices));
-        }
-        
         // Create directed graph for SCC, undirected for others
-        bool directed = (algorithmName == "scc");
-        int maxEdges = directed ? vertices * (vertices - 1) : vertices * (vertices - 1) / 2;
-        
-        if (edges < 0 || edges > maxEdges) {
-            throw std::invalid_argument("Invalid edges count: " + std::to_string(edges));
-        }
+        bool directed = (AlgorithmFactory::stringToType(algorithmName) == AlgorithmType::SCC);
+        validateCounts(vertices, edges, directed);
         
         Graph graph(vertices, directed);
         
@@ -255,30 +285,17 @@ private:
         int edgeCount = 0;
         
         while (iss >> edgeStr && edgeCount < edges) {
-            size_t dashPos = edgeStr.find('-');
-            if (dashPos == std::string::npos) {
-                throw std::invalid_argument("Invalid edge format: " + edgeStr + " (expected: u-v)");
-            }
+            EdgeToken edge = parseEdgeToken(edgeStr);
             
-            try {
-                int u = std::stoi(edgeStr.substr(0, dashPos));
-                int v = std::stoi(edgeStr.substr(dashPos + 1));
-                
-                if (u < 0 || u >= vertices || v < 0 || v >= vertices) {
-                    throw std::invalid_argument("Vertex out of range: " + edgeStr);
-                }
-                if (u == v) {
-                    throw std::invalid_argument("Self-loops not allowed: " + edgeStr);
-                }
-                
-                graph.addEdge(u, v);
-                edgeCount++;
-                
-            } catch (const std::invalid_argument& e) {
-                throw;
-            } catch (const std::exception& e) {
-                throw std::invalid_argument("Invalid edge: " + edgeStr);
+            if (edge.u < 0 || edge.u >= vertices || edge.v < 0 || edge.v >= vertices) {
+                throw std::invalid_argument("Vertex out of range: " + edgeStr);
             }
+            if (edge.u == edge.v) {
+                throw std::invalid_argument("Self-loops not allowed: " + edgeStr);
+            }
+            
+            graph.addEdge(edge.u, edge.v, edge.weight);
+            edgeCount++;
         }
         
         if (edgeCount != edges) {
@@ -286,6 +303,7 @@ private:
                                       " edges, got " + std::to_string(edgeCount));
         }
         
+        graph.freeze();
         return graph;
     }
     
@@ -310,6 +328,14 @@ private:
         return response.str();
     }
     
+    std::string formatStatistics() {
+        std::ostringstream stats;
+        stats << "\n=== Server Statistics ===\n";
+        stats << (resultCache ? resultCache->formatStats() : "Result cache: disabled\n");
+        stats << "========================";
+        return stats.str();
+    }
+    
     std::string formatError(const std::string& error) {
         return "\n=== ERROR ===\n" + error + "\n=============";
     }
@@ -341,24 +367,21 @@ private:
             } else {
                 help << "undirected graphs only\n";
             }
+            auto variants = AlgorithmFactory::getVariantNames(type);
+            if (!variants.empty()) {
+                help << "  Variants: ";
+                for (size_t i = 0; i < variants.size(); ++i) {
+                    help << AlgorithmFactory::typeToString(type) << ":" << variants[i];
+                    if (i < variants.size() - 1) help << ", ";
+                }
+                help << " (first is default)\n";
+            }
             help << "\n";
         }
         help << "===========================";
         
         return help.str();
     }
-    
-    void log(const std::string& message) {
-        std::lock_guard<std::mutex> lock(logMutex);
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto tm = *std::localtime(&time_t);
-        
-        char timeStr[20];
-        strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &tm);
-        
-        std::cout << "[" << timeStr << "] " << message << std::endl;
-    }
 };
 
 // Global server for signal handling
@@ -373,14 +396,39 @@ void signalHandler(int signal) {
 
 int main(int argc, char* argv[]) {
     int port = 8080;
+    IoBackend backend = IoBackend::AUTO;
+    size_t cacheBytes = ResultCache::DEFAULT_BYTE_BUDGET;
     
     // Parse arguments
-    if (argc > 2) {
-        std::cerr << "Usage: " << argv[0] << " [port]" << std::endl;
+    if (argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " [port] [auto|io_uring|epoll] [cache_mb]" << std::endl;
         return 1;
     }
     
-    if (argc == 2) {
+    if (argc == 4) {
+        try {
+            int megabytes = std::stoi(argv[3]);
+            if (megabytes < 0 || megabytes > 4096) {
+                std::cerr << "Cache size must be 0-4096 MB" << std::endl;
+                return 1;
+            }
+            cacheBytes = static_cast<size_t>(megabytes) << 20;
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid cache size: " << argv[3] << std::endl;
+            return 1;
+        }
+    }
+    
+    if (argc >= 3) {
+        try {
+            backend = BaseServer::stringToBackend(argv[2]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (argc >= 2) {
         try {
             port = std::stoi(argv[1]);
             if (port < 1024 || port > 65535) {
@@ -398,7 +446,7 @@ int main(int argc, char* argv[]) {
         signal(SIGINT, signalHandler);
         signal(SIGTERM, signalHandler);
         
-        AlgorithmsServer server(port);
+        AlgorithmsServer server(port, backend, cacheBytes);
         globalServer = &server;
         
         std::cout << "=== Q7: Algorithms Server (Strategy/Factory) ===" << std::endl;
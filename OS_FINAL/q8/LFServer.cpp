@@ -1,25 +1,38 @@
 #include "LFServer.h"
+#include "../servers/ServerSupport.h"
+#include "../common/EdgeToken.h"
+#include "../common/BinaryProtocol.h"
+#include "../threading/ThreadPool.h"
 #include <iostream>
 #include <sstream>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <cerrno>
 #include <cstring>
 #include <chrono>
 #include <iomanip>
 
-LFServer::LFServer(int serverPort, size_t numWorkers) 
-    : port(serverPort), running(false), serverSocket(-1), clientCounter(0),
-      waitingFollowers(0), totalRequestsProcessed(0), leaderPromotions(0), 
-      totalProcessingTime(0) {
-    
-    // Create worker threads for Leader-Follower pattern
-    for (size_t i = 0; i < numWorkers; ++i) {
-        workerThreads.emplace_back(&LFServer::workerThread, this);
+ClientConnection::~ClientConnection() {
+    close(clientSocket);
+}
+
+LFServer::LFServer(int serverPort, size_t numWorkers, AlgorithmRunner::Mode mode, size_t cacheBytes) 
+    : port(serverPort), running(false), serverSocket(-1), epollFd(-1), wakeupFd(-1), workFd(-1),
+      clientCounter(0), workerCount(numWorkers), algorithmMode(mode), activeWorkers(0),
+      pendingWork(PENDING_WORK_CAPACITY), totalRequestsProcessed(0), 
+      leaderPromotions(0), totalProcessingTime(0), pipelinedRequests(0) {
+    
+    if (cacheBytes > 0) {
+        resultCache = std::make_unique<ResultCache>(cacheBytes);
     }
     
-    log("Leader-Follower server created with " + std::to_string(numWorkers) + " worker threads");
+    log("Leader-Follower server created with " + std::to_string(numWorkers) + " worker threads, " +
+        AlgorithmRunner::modeToString(mode) + " algorithm execution, " +
+        (cacheBytes > 0 ? std::to_string(cacheBytes) + " byte result cache" : "no result cache"));
 }
 
 LFServer::~LFServer() {
@@ -33,19 +46,23 @@ void LFServer::start() {
     }
     
     try {
-        setupSocket();
+        serverSocket = ServerSupport::openListeningSocket(port);
+        setupEventLoop();
         running = true;
         
+        // Workers take turns as leader on the epoll set
+        activeWorkers = workerCount;
+        for (size_t i = 0; i < workerCount; ++i) {
+            workerThreads.emplace_back(&LFServer::workerThread, this);
+        }
+        
         log("=== Leader-Follower Server Started ===");
         log("Port: " + std::to_string(port));
         log("Worker threads: " + std::to_string(workerThreads.size()));
-        log("Protocol: Multi-algorithm requests");
-        log("Pattern: Leader-Follower threading");
+        log("Protocol: Multi-algorithm requests (newline framed)");
+        log("Pattern: Leader-Follower over epoll");
         log("=====================================");
         
-        // Start accepting clients
-        serverThread = std::thread(&LFServer::acceptClients, this);
-        
     } catch (const std::exception& e) {
         log("Failed to start server: " + std::string(e.what()));
         stop();
@@ -54,26 +71,13 @@ void LFServer::start() {
 }
 
 void LFServer::stop() {
-    if (!running) return;
-    
-    running = false;
+    bool wasRunning = running.exchange(false);
     
-    // Close server socket
-    if (serverSocket >= 0) {
-        close(serverSocket);
-        serverSocket = -1;
-    }
-    
-    // Wake up all worker threads
-    {
-        std::lock_guard<std::mutex> lock(queueMutex);
-    }
-    leaderCondition.notify_all();
-    followerCondition.notify_all();
-    
-    // Join server thread
-    if (serverThread.joinable()) {
-        serverThread.join();
+    // Wake the leader; the eventfd stays readable so every worker sees it
+    if (wakeupFd >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeupFd, &one, sizeof(one));
+        (void)ignored;
     }
     
     // Join worker threads
@@ -82,35 +86,75 @@ void LFServer::stop() {
             worker.join();
         }
     }
+    workerThreads.clear();
+    
+    // Close all client connections; queued requests hold references too
+    PipelinedRequest dropped;
+    while (pendingWork.tryPop(dropped)) {}
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        connections.clear();
+    }
+    
+    // Close server socket and event loop handles
+    if (serverSocket >= 0) {
+        close(serverSocket);
+        serverSocket = -1;
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeupFd >= 0) {
+        close(wakeupFd);
+        wakeupFd = -1;
+    }
+    if (workFd >= 0) {
+        close(workFd);
+        workFd = -1;
+    }
     
-    log("=== Leader-Follower Server Stopped ===");
+    if (wasRunning) {
+        log("=== Leader-Follower Server Stopped ===");
+    }
 }
 
-void LFServer::setupSocket() {
-    serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-    if (serverSocket < 0) {
-        throw std::runtime_error("Failed to create socket");
+void LFServer::setupEventLoop() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        throw std::runtime_error("Failed to create epoll instance");
     }
     
-    int opt = 1;
-    if (setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-        close(serverSocket);
-        throw std::runtime_error("Failed to set socket options");
+    wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeupFd < 0) {
+        throw std::runtime_error("Failed to create wakeup eventfd");
     }
     
-    struct sockaddr_in address;
-    address.sin_family = AF_INET;
-    address.sin_addr.s_addr = INADDR_ANY;
-    address.sin_port = htons(port);
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = wakeupFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeupFd, &event) < 0) {
+        throw std::runtime_error("Failed to register wakeup eventfd");
+    }
     
-    if (bind(serverSocket, (struct sockaddr*)&address, sizeof(address)) < 0) {
-        close(serverSocket);
-        throw std::runtime_error("Failed to bind to port " + std::to_string(port));
+    // Level-triggered semaphore: every leader that sees it readable claims
+    // at most one queued request, until the count drops to zero
+    workFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC | EFD_SEMAPHORE);
+    if (workFd < 0) {
+        throw std::runtime_error("Failed to create work eventfd");
+    }
+    event.events = EPOLLIN;
+    event.data.fd = workFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, workFd, &event) < 0) {
+        throw std::runtime_error("Failed to register work eventfd");
     }
     
-    if (listen(serverSocket, 10) < 0) {
-        close(serverSocket);
-        throw std::runtime_error("Failed to listen on socket");
+    // One-shot: only one worker at a time drains the accept queue
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.fd = serverSocket;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, serverSocket, &event) < 0) {
+        throw std::runtime_error("Failed to register server socket");
     }
 }
 
@@ -119,184 +163,480 @@ void LFServer::acceptClients() {
         struct sockaddr_in clientAddr;
         socklen_t clientLen = sizeof(clientAddr);
         
-        int clientSocket = accept(serverSocket, (struct sockaddr*)&clientAddr, &clientLen);
+        int clientSocket = accept4(serverSocket, (struct sockaddr*)&clientAddr, &clientLen,
+                                   SOCK_NONBLOCK | SOCK_CLOEXEC);
         if (clientSocket < 0) {
-            if (running) {
-                log("Failed to accept client connection");
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK && running) {
+                log("Failed to accept client connection: " + std::string(strerror(errno)));
             }
-            continue;
+            break;
         }
         
         int clientId = ++clientCounter;
         std::string clientIP = inet_ntoa(clientAddr.sin_addr);
         logRequest(clientId, "Connected from " + clientIP);
         
-        // Handle client in separate thread (not part of LF pool)
-        std::thread clientThread(&LFServer::handleNewClient, this, clientSocket, clientId);
-        clientThread.detach();
+        auto connection = std::make_shared<ClientConnection>(clientSocket, clientId);
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections[clientSocket] = connection;
+        }
+        
+        // Registered disarmed; queueing the welcome arms it
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLONESHOT;
+        event.data.fd = clientSocket;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientSocket, &event) < 0) {
+            logRequest(clientId, "Failed to register with epoll");
+            closeClient(clientSocket);
+            continue;
+        }
+        if (!sendReply(*connection, 0, welcomeMessage(clientId))) {
+            closeClient(clientSocket);
+        }
     }
 }
 
-void LFServer::handleNewClient(int clientSocket, int clientId) {
-    try {
-        // Send welcome message
-        std::string welcome = 
-            "=== Leader-Follower Algorithms Server ===\n"
-            "Client ID: " + std::to_string(clientId) + "\n"
-            "Format: vertices edges edge1 edge2 ...\n"
-            "All algorithms will be executed: euler, clique, mst, hamilton, scc\n"
-            "\n"
-            "Examples:\n"
-            "  3 3 0-1 1-2 2-0    (triangle - works for most algorithms)\n"
-            "  4 4 0-1 1-2 2-3 3-0  (square - good test case)\n"
-            "\n"
-            "Commands: help, stats, quit\n"
-            "> ";
-        
-        send(clientSocket, welcome.c_str(), welcome.length(), 0);
+std::string LFServer::welcomeMessage(int clientId) const {
+    return
+        "=== Leader-Follower Algorithms Server ===\n"
+        "Client ID: " + std::to_string(clientId) + "\n"
+        "Format: [algorithms] vertices edges edge1 edge2 ...\n"
+        "Edge format: u-v or weighted u-v:w (weights are used by mst)\n"
+        "Algorithms: comma-separated list of euler, clique, mst, hamilton, scc\n"
+        "            (all of them when omitted)\n"
+        "\n"
+        "Examples:\n"
+        "  3 3 0-1 1-2 2-0    (triangle - works for most algorithms)\n"
+        "  4 4 0-1 1-2 2-3 3-0  (square - good test case)\n"
+        "  mst,scc 3 3 0-1:4 1-2:2 2-0:7  (only mst and scc)\n"
+        "\n"
+        "Commands: help, stats, estimate [algorithms] vertices edges,\n"
+        "          pipeline on|off, quit\n"
+        "Binary GBIN frames are accepted too (algorithm mask, packed edges),\n"
+        "and GBAT batch frames (many graphs, one mask, one combined reply)\n"
+        "> ";
+}
+
+void LFServer::workerThread() {
+    while (running) {
+        struct epoll_event event;
         
-        char buffer[2048];
-        while (running) {
-            memset(buffer, 0, sizeof(buffer));
-            int bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-            
-            if (bytesRead <= 0) {
-                logRequest(clientId, "Disconnected");
-                break;
-            }
-            
-            std::string input(buffer);
-            input.erase(input.find_last_not_of("\r\n") + 1);
+        {
+            // Followers wait here; whoever holds the lock is the leader
+            std::lock_guard<std::mutex> leader(leaderMutex);
+            if (!running) break;
+            leaderPromotions++;
             
-            logRequest(clientId, "Request: " + input);
+            int ready;
+            do {
+                ready = epoll_wait(epollFd, &event, 1, -1);
+            } while (ready < 0 && errno == EINTR && running);
             
-            if (input == "quit" || input == "exit") {
-                std::string response = "Goodbye!\n";
-                send(clientSocket, response.c_str(), response.length(), 0);
+            if (!running) break;
+            if (ready < 0) {
+                // EBADF, EFAULT or EINVAL: the epoll set is unusable, retrying would spin
+                log("Worker stopping, epoll_wait failed: " + std::string(strerror(errno)) + " (" +
+                    std::to_string(activeWorkers - 1) + " of " + std::to_string(workerCount) + " workers left)");
                 break;
-            } else if (input == "help") {
-                send(clientSocket, welcome.c_str(), welcome.length(), 0);
-                continue;
-            } else if (input == "stats") {
-                std::ostringstream stats;
-                stats << "\n=== Server Statistics ===\n";
-                stats << "Requests processed: " << totalRequestsProcessed << "\n";
-                stats << "Leader promotions: " << leaderPromotions << "\n";
-                stats << "Worker threads: " << workerThreads.size() << "\n";
-                stats << "========================\n> ";
-                std::string statsStr = stats.str();
-                send(clientSocket, statsStr.c_str(), statsStr.length(), 0);
-                continue;
-            } else if (input.empty()) {
-                std::string response = "Empty input. Type 'help' for usage.\n> ";
-                send(clientSocket, response.c_str(), response.length(), 0);
-                continue;
-            }
-            
-            // Create request and add to Leader-Follower queue
-            auto request = std::make_shared<ClientRequest>(clientId, clientSocket, input);
-            
-            {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                requestQueue.push(request);
             }
-            
-            // Wake up the leader to process request
-            leaderCondition.notify_one();
-            
-            logRequest(clientId, "Request queued for LF processing");
+            // Leaving this scope promotes the next follower to leader
         }
         
-    } catch (const std::exception& e) {
-        logRequest(clientId, "Error: " + std::string(e.what()));
+        // Process the ready handle outside of leadership
+        handleEvent(event.data.fd, event.events);
     }
-    
-    close(clientSocket);
+    activeWorkers--;
 }
 
-void LFServer::workerThread() {
-    std::thread::id myId = std::this_thread::get_id();
+void LFServer::handleEvent(int fd, uint32_t events) {
+    if (fd == wakeupFd) {
+        return;
+    }
     
-    while (running) {
-        std::shared_ptr<ClientRequest> request;
-        bool hasRequest = false;
+    if (fd == workFd) {
+        runPendingWork();
+        return;
+    }
+    
+    if (fd == serverSocket) {
+        acceptClients();
+        rearmAccept();
+        return;
+    }
+    
+    std::shared_ptr<ClientConnection> connection;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+        connection = it->second;
+    }
+    
+    {
+        // A reply queued between this event and here may have re-armed the
+        // socket for another worker; whichever comes second leaves its
+        // events to the first
+        std::lock_guard<std::mutex> lock(connection->sendMutex);
+        if (connection->handling) {
+            connection->missedEvents |= events;
+            return;
+        }
+        connection->handling = true;
+    }
+    
+    bool broken = false;
+    while (true) {
+        broken = broken || (events & (EPOLLERR | EPOLLHUP)) != 0;
+        if (!broken && (events & EPOLLOUT)) {
+            std::lock_guard<std::mutex> lock(connection->sendMutex);
+            broken = !flushOutput(*connection);
+        }
+        if (!broken && (events & (EPOLLIN | EPOLLRDHUP)) && !connection->closeAfterFlush &&
+            !readClient(connection)) {
+            // quit, a broken stream or the client closing: replies go out first
+            std::lock_guard<std::mutex> lock(connection->sendMutex);
+            connection->closeAfterFlush = true;
+        }
         
-        // Leader-Follower logic
         {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            
-            // Try to become leader if no leader exists
-            if (currentLeader == std::thread::id{} && becomeLeader()) {
-                // I'm now the leader
-                leaderPromotions++;
-                
-                // Wait for a request
-                leaderCondition.wait(lock, [this] {
-                    return !running || !requestQueue.empty();
-                });
-                
-                if (!running) break;
-                
-                if (!requestQueue.empty()) {
-                    request = requestQueue.front();
-                    requestQueue.pop();
-                    hasRequest = true;
-                    
-                    // Give up leadership
-                    {
-                        std::lock_guard<std::mutex> leaderLock(leaderMutex);
-                        currentLeader = std::thread::id{};
-                    }
-                    
-                    // Promote new leader
-                    promoteNewLeader();
-                }
-            } else {
-                // I'm a follower
-                waitingFollowers++;
-                
-                // Wait to be promoted to leader
-                followerCondition.wait(lock, [this, myId] {
-                    return !running || currentLeader == myId;
-                });
-                
-                waitingFollowers--;
-                
-                if (!running) break;
-                
-                // If promoted to leader, continue to next iteration
+            std::lock_guard<std::mutex> lock(connection->sendMutex);
+            if (!broken && connection->missedEvents != 0) {
+                events = connection->missedEvents;
+                connection->missedEvents = 0;
                 continue;
             }
+            connection->handling = false;
+            bool finished = broken || (connection->closeAfterFlush && connection->outputBuffer.empty() &&
+                                       connection->inFlight == 0);
+            if (!finished) {
+                updateInterest(*connection, true);
+                return;
+            }
         }
-        
-        // Process request outside of lock
-        if (hasRequest) {
-            processRequest(request);
+        closeClient(fd);
+        return;
+    }
+}
+
+bool LFServer::readClient(const std::shared_ptr<ClientConnection>& connection) {
+    // Drain the socket (it is non-blocking). Requests are parsed as the
+    // bytes arrive and handled as soon as each one is complete.
+    char buffer[4096];
+    while (true) {
+        {
+            // Past the output limit the rest stays in the socket until replies drain
+            std::lock_guard<std::mutex> lock(connection->sendMutex);
+            if (connection->throttled) break;
+        }
+        ssize_t bytesRead = recv(connection->clientSocket, buffer, sizeof(buffer), 0);
+        if (bytesRead > 0) {
+            connection->requests.append(buffer, bytesRead);
+            if (!handleRequests(connection)) {
+                return false;
+            }
+            continue;
+        }
+        if (bytesRead == 0) {
+            logRequest(connection->clientId, "Disconnected");
+            return false;
         }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        logRequest(connection->clientId, "Receive error: " + std::string(strerror(errno)));
+        return false;
     }
+    return true;
 }
 
-bool LFServer::becomeLeader() {
-    std::lock_guard<std::mutex> lock(leaderMutex);
-    if (currentLeader == std::thread::id{}) {
-        currentLeader = std::this_thread::get_id();
-        return true;
+bool LFServer::handleRequests(const std::shared_ptr<ClientConnection>& connection) {
+    RequestStream& requests = connection->requests;
+    StreamMessage request;
+    while (requests.next(request)) {
+        // Numbered as they arrive; 0 means "reply untagged"
+        uint64_t requestId = connection->pipelined ? connection->nextRequestId++ : 0;
+        bool keepOpen = (request.kind == StreamMessage::Kind::LINE)
+                            ? handleLine(*connection, requestId, request.text)
+                            : handleGraph(connection, requestId, request);
+        if (!keepOpen) {
+            return false;
+        }
     }
-    return false;
+    
+    // A broken frame header or an endless line leaves no way to find the next request
+    if (requests.failed()) {
+        uint64_t requestId = connection->pipelined ? connection->nextRequestId++ : 0;
+        sendReply(*connection, requestId,
+                  requests.failedInFrame()
+                      ? BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR, requests.failure())
+                      : ServerSupport::formatError(requests.failure(), connection->clientId) + "\n");
+        return false;
+    }
+    return true;
 }
 
-void LFServer::promoteNewLeader() {
-    if (waitingFollowers > 0) {
-        // Promote one follower to leader
+bool LFServer::handleLine(ClientConnection& connection, uint64_t requestId, const std::string& input) {
+    int clientId = connection.clientId;
+    
+    logRequest(clientId, "Request: " + input);
+    
+    if (input == "quit" || input == "exit") {
+        sendReply(connection, requestId, "Goodbye!\n");
+        return false;
+    } else if (input == "help") {
+        return sendReply(connection, requestId, welcomeMessage(clientId));
+    } else if (input == "pipeline on" || input == "pipeline off") {
+        // Applies from the next request on; this reply is tagged as before
+        connection.pipelined = (input == "pipeline on");
+        return sendReply(connection, requestId,
+                         connection.pipelined ? "Pipelined mode: on (replies are tagged \"#<id> <length>\")\n"
+                                              : "Pipelined mode: off\n> ");
+    } else if (input == "stats") {
+        std::ostringstream stats;
+        stats << "\n=== Server Statistics ===\n";
+        stats << "Requests processed: " << totalRequestsProcessed << "\n";
+        stats << "Pipelined requests: " << pipelinedRequests << "\n";
+        stats << "Leader promotions: " << leaderPromotions << "\n";
+        stats << "Worker threads: " << workerCount << "\n";
+        stats << "Algorithm execution: " << AlgorithmRunner::modeToString(algorithmMode) << "\n";
+        stats << (resultCache ? resultCache->formatStats() : "Result cache: disabled\n");
         {
-            std::lock_guard<std::mutex> lock(leaderMutex);
-            // The promoted thread will set itself as leader
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            stats << "Open connections: " << connections.size() << "\n";
+        }
+        stats << "========================\n> ";
+        return sendReply(connection, requestId, stats.str());
+    } else if (input.compare(0, 9, "estimate ") == 0) {
+        try {
+            std::istringstream iss(input.substr(9));
+            int vertices, edges;
+            AlgorithmRunner::Mask mask = parseHead(iss, vertices, edges);
+            return sendReply(connection, requestId, withPrompt(formatEstimates(mask, vertices, edges), requestId));
+        } catch (const std::exception& e) {
+            return sendReply(connection, requestId,
+                             withPrompt(ServerSupport::formatError(e.what(), clientId), requestId));
+        }
+    } else if (input.empty()) {
+        return sendReply(connection, requestId, "Empty input. Type 'help' for usage.\n> ");
+    }
+    
+    // The thread that received the request processes it
+    processRequest(connection, std::make_shared<ClientRequest>(clientId, requestId, input));
+    return true;
+}
+
+bool LFServer::handleGraph(const std::shared_ptr<ClientConnection>& connection, uint64_t requestId,
+                           StreamMessage& request) {
+    int clientId = connection->clientId;
+    if (request.kind == StreamMessage::Kind::GRAPH && request.text == "estimate") {
+        // "estimate vertices edges" has the shape of a graph line
+        std::string reply;
+        try {
+            reply = formatEstimates(AlgorithmRunner::ALL_ALGORITHMS, request.vertices, request.edgeCount);
+        } catch (const std::exception& e) {
+            reply = ServerSupport::formatError(e.what(), clientId);
+        }
+        return sendReply(*connection, requestId, withPrompt(reply, requestId));
+    }
+    if (request.kind == StreamMessage::Kind::BATCH) {
+        logRequest(clientId, "Batch request: " + std::to_string(request.graphs.size()) + " graphs");
+    } else {
+        logRequest(clientId, std::string(request.kind == StreamMessage::Kind::FRAME ? "Binary request: "
+                                                                                      : "Graph request: ") +
+                   std::to_string(request.vertices) + " vertices, " + std::to_string(request.edgeCount) + " edges");
+    }
+    
+    // Pipelined requests go to whichever worker leads next, so the reader
+    // can go on reading; the reply is sent by the worker that finishes it.
+    // Cheap ones are not worth the hand-off.
+    if (requestId != 0 && connection->inFlight < MAX_IN_FLIGHT && estimateCost(request) >= INLINE_COST) {
+        PipelinedRequest work{connection, requestId, std::move(request)};
+        connection->inFlight++;
+        if (pendingWork.tryPush(work)) {
+            pipelinedRequests++;
+            uint64_t one = 1;
+            ssize_t ignored = write(workFd, &one, sizeof(one));
+            (void)ignored;
+            return true;
         }
-        followerCondition.notify_one();
+        // Queue full: answer it here, as for a connection at MAX_IN_FLIGHT
+        connection->inFlight--;
+        request = std::move(work.request);
     }
+    
+    return sendReply(*connection, requestId, answerGraph(request, requestId, clientId));
 }
 
-void LFServer::processRequest(std::shared_ptr<ClientRequest> request) {
+void LFServer::runPendingWork() {
+    // Claim one count; another leader may have taken it first
+    uint64_t claimed;
+    if (read(workFd, &claimed, sizeof(claimed)) != sizeof(claimed)) {
+        return;
+    }
+    
+    // Every count follows a finished push, but an earlier slot may still be
+    // mid-push by another reader; it is published within a few instructions
+    PipelinedRequest work;
+    while (!pendingWork.tryPop(work)) {
+        std::this_thread::yield();
+    }
+    
+    // A failed send shuts the connection down (see sendReply)
+    sendReply(*work.connection, work.requestId, answerGraph(work.request, work.requestId, work.connection->clientId));
+    work.connection->inFlight--;
+    
+    // A closing connection waits for its last in-flight reply
+    std::lock_guard<std::mutex> lock(work.connection->sendMutex);
+    updateInterest(*work.connection);
+}
+
+std::string LFServer::answerGraph(const StreamMessage& request, uint64_t requestId, int clientId) {
+    if (request.kind == StreamMessage::Kind::BATCH) {
+        return answerBatch(request, clientId);
+    }
+    
+    // Frames get a framed reply
+    bool framed = (request.kind == StreamMessage::Kind::FRAME);
+    auto start = std::chrono::high_resolution_clock::now();
+    try {
+        std::string body = analyzeGraph(request, requestMask(request), clientId, algorithmMode);
+        
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+        totalProcessingTime += duration.count();
+        totalRequestsProcessed++;
+        logRequest(clientId, "Completed in " + std::to_string(duration.count()) + "μs");
+        return framed ? BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_OK, body) : withPrompt(body, requestId);
+    } catch (const std::exception& e) {
+        logRequest(clientId, "Error: " + std::string(e.what()));
+        std::string error = ServerSupport::formatError(e.what(), clientId);
+        return framed ? BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR, error)
+                      : withPrompt(error, requestId);
+    }
+}
+
+std::string LFServer::answerBatch(const StreamMessage& batch, int clientId) {
+    // Graphs spread over the shared pool, this worker included. Each graph
+    // runs its algorithms serially: the graphs are the parallelism here, and
+    // small graphs gain nothing from fanning out further.
+    auto start = std::chrono::high_resolution_clock::now();
+    const std::vector<StreamMessage>& graphs = batch.graphs;
+    std::vector<std::string> replies(graphs.size());
+    ThreadPool::shared().parallelFor(0, graphs.size(), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            try {
+                replies[i] = BinaryProtocol::encodeResponse(
+                    BinaryProtocol::STATUS_OK,
+                    analyzeGraph(graphs[i], graphs[i].algorithmMask, clientId, AlgorithmRunner::Mode::SERIAL));
+            } catch (const std::exception& e) {
+                replies[i] = BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR,
+                                                            ServerSupport::formatError(e.what(), clientId));
+            }
+        }
+    });
+    
+    size_t length = 0;
+    for (const std::string& reply : replies) {
+        length += reply.size();
+    }
+    std::string body;
+    body.reserve(length);
+    for (const std::string& reply : replies) {
+        body += reply;
+    }
+    
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    totalProcessingTime += duration.count();
+    totalRequestsProcessed += graphs.size();
+    logRequest(clientId, "Batch of " + std::to_string(graphs.size()) + " graphs completed in " +
+               std::to_string(duration.count()) + "μs");
+    return BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_OK, body);
+}
+
+void LFServer::rearmAccept() {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.fd = serverSocket;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, serverSocket, &event);
+}
+
+void LFServer::closeClient(int fd) {
+    // The socket itself is closed by the last holder of the connection
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    auto it = connections.find(fd);
+    if (it != connections.end()) {
+        {
+            std::lock_guard<std::mutex> sendLock(it->second->sendMutex);
+            it->second->closed = true;
+        }
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        connections.erase(it);
+    }
+}
+
+bool LFServer::sendReply(ClientConnection& connection, uint64_t requestId, const std::string& reply) {
+    // Never blocks: what the socket does not take now waits for EPOLLOUT
+    std::lock_guard<std::mutex> lock(connection.sendMutex);
+    if (connection.closed) {
+        return false;
+    }
+    if (requestId != 0) {
+        connection.outputBuffer += "#" + std::to_string(requestId) + " " + std::to_string(reply.size()) + "\n";
+    }
+    connection.outputBuffer += reply;
+    if (!flushOutput(connection)) {
+        // The client may have part of a "#<id> <length>" reply; end the
+        // connection rather than send anything after it. Its handler sees
+        // the hang-up and closes it.
+        shutdown(connection.clientSocket, SHUT_RDWR);
+        return false;
+    }
+    updateInterest(connection);
+    return true;
+}
+
+bool LFServer::flushOutput(ClientConnection& connection) {
+    // Caller holds sendMutex; false once the socket is broken
+    std::string& output = connection.outputBuffer;
+    bool ok = ServerSupport::sendPending(connection.clientSocket, output);
+    
+    // Stop reading above the limit, resume below half of it
+    connection.throttled = output.size() > (connection.throttled ? MAX_OUTPUT_BACKLOG / 2 : MAX_OUTPUT_BACKLOG);
+    return ok;
+}
+
+void LFServer::updateInterest(ClientConnection& connection, bool force) {
+    // Caller holds sendMutex. A socket being handled is re-armed by its
+    // handler when it is done.
+    if (connection.handling || connection.closed) {
+        return;
+    }
+    uint32_t events = EPOLLONESHOT;
+    if (!connection.throttled && !connection.closeAfterFlush) {
+        events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (!connection.outputBuffer.empty() || (connection.closeAfterFlush && connection.inFlight == 0)) {
+        events |= EPOLLOUT;
+    }
+    // EPOLLONESHOT disarms the socket once an event is taken, so the
+    // handler re-arms even when the interest is unchanged
+    if (events == connection.armedEvents && !force) {
+        return;
+    }
+    
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.fd = connection.clientSocket;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.clientSocket, &event);
+    connection.armedEvents = events;
+}
+
+void LFServer::processRequest(ClientConnection& connection, std::shared_ptr<ClientRequest> request) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -309,15 +649,14 @@ void LFServer::processRequest(std::shared_ptr<ClientRequest> request) {
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
         totalProcessingTime += duration.count();
         
-        response += "\n> ";
-        send(request->clientSocket, response.c_str(), response.length(), 0);
+        sendReply(connection, request->requestId, withPrompt(response, request->requestId));
         
         totalRequestsProcessed++;
         logRequest(request->clientId, "Completed in " + std::to_string(duration.count()) + "μs");
         
     } catch (const std::exception& e) {
-        std::string errorResponse = formatError(e.what(), request->clientId) + "\n> ";
-        send(request->clientSocket, errorResponse.c_str(), errorResponse.length(), 0);
+        std::string errorResponse = ServerSupport::formatError(e.what(), request->clientId);
+        sendReply(connection, request->requestId, withPrompt(errorResponse, request->requestId));
         logRequest(request->clientId, "Error: " + std::string(e.what()));
     }
 }
@@ -326,155 +665,124 @@ std::string LFServer::parseAndExecuteAlgorithms(const std::string& input, int cl
     // Parse graph
     std::istringstream iss(input);
     int vertices, edges;
-    
-    if (!(iss >> vertices)) {
-        throw std::invalid_argument("Missing vertices count");
-    }
-    if (!(iss >> edges)) {
-        throw std::invalid_argument("Missing edges count");
-    }
+    AlgorithmRunner::Mask mask = parseHead(iss, vertices, edges);
     
     if (vertices <= 0 || vertices > 50) {
         throw std::invalid_argument("Vertices must be 1-50");
     }
     
-    // Parse edges into undirected graph first
-    Graph undirectedGraph(vertices, false);
-    std::vector<std::pair<int, int>> edgeList;
-    
+    StreamMessage request;
+    request.vertices = vertices;
+    request.edgeCount = edges;
     std::string edgeStr;
-    int edgeCount = 0;
     
-    while (iss >> edgeStr && edgeCount < edges) {
-        size_t dashPos = edgeStr.find('-');
-        if (dashPos == std::string::npos) {
-            throw std::invalid_argument("Invalid edge: " + edgeStr);
-        }
+    while (iss >> edgeStr && static_cast<int>(request.edges.size()) < edges) {
+        EdgeToken edge = parseEdgeToken(edgeStr);
         
-        int u = std::stoi(edgeStr.substr(0, dashPos));
-        int v = std::stoi(edgeStr.substr(dashPos + 1));
-        
-        if (u < 0 || u >= vertices || v < 0 || v >= vertices || u == v) {
+        if (edge.u < 0 || edge.u >= vertices || edge.v < 0 || edge.v >= vertices || edge.u == edge.v) {
             throw std::invalid_argument("Invalid edge: " + edgeStr);
         }
         
-        undirectedGraph.addEdge(u, v);
-        edgeList.emplace_back(u, v);
-        edgeCount++;
+        request.edges.push_back(edge);
     }
     
-    if (edgeCount != edges) {
-        throw std::invalid_argument("Edge count mismatch");
+    return analyzeGraph(request, mask, clientId, algorithmMode);
+}
+
+std::string LFServer::formatEstimates(AlgorithmRunner::Mask mask, int vertices, int edges) {
+    if (vertices <= 0 || vertices > 50) {
+        throw std::invalid_argument("Vertices must be 1-50");
     }
-    
-    // Create directed graph for SCC
-    Graph directedGraph(vertices, true);
-    for (const auto& edge : edgeList) {
-        directedGraph.addEdge(edge.first, edge.second);
+    if (edges < 0) {
+        throw std::invalid_argument("Edge count must not be negative");
     }
     
-    // Execute ALL algorithms
-    std::vector<AlgorithmResult> results;
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    // Algorithm 1: Euler Circuit (undirected)
-    try {
-        auto eulerAlg = AlgorithmFactory::createAlgorithm(AlgorithmType::EULER_CIRCUIT);
-        results.push_back(eulerAlg->execute(undirectedGraph));
-    } catch (const std::exception& e) {
-        AlgorithmResult errorResult(AlgorithmType::EULER_CIRCUIT);
-        errorResult.success = false;
-        errorResult.error = e.what();
-        results.push_back(errorResult);
+    std::ostringstream response;
+    response << std::setprecision(3);
+    response << "\n=== COST ESTIMATES (steps) ===\n";
+    response << "Graph: " << vertices << " vertices, " << edges << " edges\n";
+    for (AlgorithmType type : AlgorithmFactory::getAllAlgorithmTypes()) {
+        if (mask & AlgorithmRunner::maskOf(type)) {
+            response << "• " << AlgorithmFactory::typeToString(type) << ": "
+                     << AlgorithmRunner::estimateCost(type, vertices, edges) << "\n";
+        }
     }
-    
-    // Algorithm 2: Max Clique (undirected, if small enough)
-    try {
-        auto cliqueAlg = AlgorithmFactory::createAlgorithm(AlgorithmType::MAX_CLIQUE);
-        results.push_back(cliqueAlg->execute(undirectedGraph));
-    } catch (const std::exception& e) {
-        AlgorithmResult errorResult(AlgorithmType::MAX_CLIQUE);
-        errorResult.success = false;
-        errorResult.error = e.what();
-        results.push_back(errorResult);
+    response << "Total: " << AlgorithmRunner::estimateCost(mask, vertices, edges) << "\n";
+    response << "================================";
+    return response.str();
+}
+
+AlgorithmRunner::Mask LFServer::parseHead(std::istream& input, int& vertices, int& edges) {
+    // "[algorithms] vertices edges"; the list is there when the first token is not a number
+    AlgorithmRunner::Mask mask = AlgorithmRunner::ALL_ALGORITHMS;
+    std::string first;
+    if (!(input >> first)) {
+        throw std::invalid_argument("Missing vertices count");
     }
-    
-    // Algorithm 3: MST (undirected)
-    try {
-        auto mstAlg = AlgorithmFactory::createAlgorithm(AlgorithmType::MST_WEIGHT);
-        results.push_back(mstAlg->execute(undirectedGraph));
-    } catch (const std::exception& e) {
-        AlgorithmResult errorResult(AlgorithmType::MST_WEIGHT);
-        errorResult.success = false;
-        errorResult.error = e.what();
-        results.push_back(errorResult);
+    std::istringstream count(first);
+    if (!(count >> vertices) || !count.eof()) {
+        mask = AlgorithmRunner::maskFromList(first);
+        if (!(input >> vertices)) {
+            throw std::invalid_argument("Missing vertices count");
+        }
     }
-    
-    // Algorithm 4: Hamilton Circuit (undirected, if small enough)
-    try {
-        auto hamiltonAlg = AlgorithmFactory::createAlgorithm(AlgorithmType::HAMILTON_CIRCUIT);
-        results.push_back(hamiltonAlg->execute(undirectedGraph));
-    } catch (const std::exception& e) {
-        AlgorithmResult errorResult(AlgorithmType::HAMILTON_CIRCUIT);
-        errorResult.success = false;
-        errorResult.error = e.what();
-        results.push_back(errorResult);
+    if (!(input >> edges)) {
+        throw std::invalid_argument("Missing edges count");
     }
-    
-    // Algorithm 5: SCC (directed)
-    try {
-        auto sccAlg = AlgorithmFactory::createAlgorithm(AlgorithmType::SCC);
-        results.push_back(sccAlg->execute(directedGraph));
-    } catch (const std::exception& e) {
-        AlgorithmResult errorResult(AlgorithmType::SCC);
-        errorResult.success = false;
-        errorResult.error = e.what();
-        results.push_back(errorResult);
+    return mask;
+}
+
+AlgorithmRunner::Mask LFServer::requestMask(const StreamMessage& request) {
+    // Frames carry a mask; graph lines may name their algorithms up front
+    if (request.kind != StreamMessage::Kind::GRAPH) {
+        return request.algorithmMask;
     }
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    
-    return formatResponse(results, clientId, duration.count());
+    return request.text.empty() ? AlgorithmRunner::ALL_ALGORITHMS : AlgorithmRunner::maskFromList(request.text);
 }
 
-std::string LFServer::formatResponse(const std::vector<AlgorithmResult>& results, 
-                                   int clientId, long long totalTime) {
-    std::ostringstream response;
-    
-    response << "\n=== MULTI-ALGORITHM ANALYSIS ===\n";
-    response << "Client: " << clientId << "\n";
-    response << "Thread: " << std::hash<std::thread::id>{}(std::this_thread::get_id()) % 1000 << "\n";
-    response << "Algorithms executed: " << results.size() << "\n";
-    response << "Total time: " << totalTime << "ms\n";
-    response << "\n";
-    
-    for (const auto& result : results) {
-        response << "• " << AlgorithmFactory::typeToString(result.type) << ": ";
-        if (result.success) {
-            response << result.result;
-            if (!result.executionTime.empty()) {
-                response << " (" << result.executionTime << ")";
-            }
-        } else {
-            response << "ERROR - " << result.error;
+double LFServer::estimateCost(const StreamMessage& request) {
+    if (request.kind == StreamMessage::Kind::BATCH) {
+        double cost = 0;
+        for (const StreamMessage& graph : request.graphs) {
+            cost += estimateCost(graph);
         }
-        response << "\n";
+        return cost;
+    }
+    try {
+        AlgorithmRunner::Mask mask = requestMask(request);
+        return AlgorithmRunner::estimateCost(mask, request.vertices, request.edgeCount);
+    } catch (const std::invalid_argument&) {
+        return 0;                // answered with an error right away
     }
-    
-    response << "===============================";
-    return response.str();
 }
 
-std::string LFServer::formatError(const std::string& error, int clientId) {
-    std::ostringstream response;
-    response << "\n=== ERROR ===\n";
-    if (clientId >= 0) {
-        response << "Client: " << clientId << "\n";
+std::string LFServer::analyzeGraph(const StreamMessage& request, AlgorithmRunner::Mask mask, int clientId,
+                                   AlgorithmRunner::Mode mode) {
+    std::unique_ptr<Graph> undirectedGraph;
+    std::unique_ptr<Graph> directedGraph;
+    ServerSupport::buildGraphs(request.vertices, request.edges, undirectedGraph, directedGraph);
+    if (!request.error.empty()) {
+        throw std::invalid_argument(request.error);
     }
-    response << "Error: " << error << "\n";
-    response << "=============";
-    return response.str();
+    if (static_cast<int>(request.edges.size()) != request.edgeCount) {
+        throw std::invalid_argument("Edge count mismatch");
+    }
+    
+    // Execute the selected algorithms
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<AlgorithmResult> results = AlgorithmRunner::runAll(*undirectedGraph, *directedGraph, mode,
+                                                                   resultCache.get(), mask);
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    int threadTag = static_cast<int>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % 1000);
+    return ServerSupport::formatAnalysis(results, clientId, duration.count(), threadTag);
+}
+
+std::string LFServer::withPrompt(const std::string& text, uint64_t requestId) {
+    // Tagged replies are delimited by their length; there is no prompt to wait for
+    return text + (requestId == 0 ? "\n> " : "\n");
 }
 
 void LFServer::log(const std::string& message) {
@@ -494,7 +802,9 @@ void LFServer::printStatistics() const {
     std::cout << "\n=== Leader-Follower Server Statistics ===" << std::endl;
     std::cout << "Total requests processed: " << totalRequestsProcessed << std::endl;
     std::cout << "Leader promotions: " << leaderPromotions << std::endl;
-    std::cout << "Worker threads: " << workerThreads.size() << std::endl;
+    std::cout << "Worker threads: " << workerCount << std::endl;
+    std::cout << "Algorithm execution: " << AlgorithmRunner::modeToString(algorithmMode) << std::endl;
+    std::cout << (resultCache ? resultCache->formatStats() : "Result cache: disabled\n");
     std::cout << "Average processing time: ";
     if (totalRequestsProcessed > 0) {
         std::cout << (totalProcessingTime / totalRequestsProcessed) << "μs" << std::endl;
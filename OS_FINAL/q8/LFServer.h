@@ -2,55 +2,115 @@
 #define LF_SERVER_H
 
 #include "../common/Graph.h"
+#include "../common/RequestStream.h"
 #include "../algorithms/AlgorithmFactory.h"
+#include "../algorithms/AlgorithmRunner.h"
+#include "../threading/MPMCQueue.h"
 #include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
 #include <atomic>
 #include <functional>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 struct ClientRequest {
     int clientId;
-    int clientSocket;
+    uint64_t requestId;          // 0 unless the connection is pipelined
     std::string requestData;
     std::chrono::steady_clock::time_point timestamp;
     
-    ClientRequest(int id, int socket, const std::string& data) 
-        : clientId(id), clientSocket(socket), requestData(data),
+    ClientRequest(int id, uint64_t requestId, const std::string& data) 
+        : clientId(id), requestId(requestId), requestData(data),
           timestamp(std::chrono::steady_clock::now()) {}
 };
 
+// One connected client. A single worker handles a connection's events at a
+// time ('handling'), so the request stream needs no lock of its own.
+//
+// In pipelined mode ("pipeline on") the n-th request sent in that mode gets
+// id n and graph requests may run on any worker; each reply goes out as
+// soon as it is ready, prefixed with "#<id> <length>\n".
+// Replies are queued in outputBuffer under sendMutex and written without
+// blocking; whatever the socket does not take is flushed on EPOLLOUT. The
+// socket is closed only when the last request holding the connection is
+// done, so a late reply can never reach a reused descriptor.
+struct ClientConnection {
+    int clientSocket;
+    int clientId;
+    RequestStream requests;      // bytes received after the last complete request
+    bool pipelined;              // reader side only, like 'requests'
+    uint64_t nextRequestId;
+    std::atomic<int> inFlight;   // pipelined requests handed to other workers
+    
+    // Guarded by sendMutex
+    std::mutex sendMutex;
+    std::string outputBuffer;    // replies the socket has not taken yet
+    bool handling;               // a worker is processing an event for this socket
+    uint32_t missedEvents;       // events delivered while another worker was handling it
+    uint32_t armedEvents;        // interest last registered with epoll
+    bool throttled;              // too much unsent output: not reading
+    bool closeAfterFlush;        // close once the replies and in-flight requests are done
+    bool closed;                 // no longer in the epoll set
+    
+    ClientConnection(int socket, int id)
+        : clientSocket(socket), clientId(id), requests(RequestStream::GraphLines::OPTIONAL_COMMAND_COUNTS),
+          pipelined(false), nextRequestId(1), inFlight(0), handling(false), missedEvents(0),
+          armedEvents(0), throttled(false), closeAfterFlush(false), closed(false) {}
+    ~ClientConnection();
+};
+
+// A pipelined graph request waiting for a worker
+struct PipelinedRequest {
+    std::shared_ptr<ClientConnection> connection;
+    uint64_t requestId;
+    StreamMessage request;
+};
+
+// Leader-Follower over a single epoll handle set:
+// the leader blocks in epoll_wait for one event, hands leadership to the next
+// follower by releasing leaderMutex, then processes the ready socket itself.
+// Sockets are non-blocking and registered EPOLLONESHOT, and are re-armed once
+// their handler is done - no thread per connection.
 class LFServer {
 private:
     // Server basics
     int port;
     std::atomic<bool> running;
     int serverSocket;
-    std::thread serverThread;
-    int clientCounter;
+    int epollFd;
+    int wakeupFd;                // eventfd: wakes the leader on stop()
+    int workFd;                  // semaphore eventfd: one count per queued pipelined request
+    std::atomic<int> clientCounter;
     
     // Leader-Follower pattern
+    size_t workerCount;
+    AlgorithmRunner::Mode algorithmMode;    // FAN_OUT runs a request's algorithms concurrently
+    std::unique_ptr<ResultCache> resultCache;   // null when caching is disabled
     std::vector<std::thread> workerThreads;
-    std::queue<std::shared_ptr<ClientRequest>> requestQueue;
-    std::mutex queueMutex;
-    std::condition_variable leaderCondition;
-    std::condition_variable followerCondition;
+    std::mutex leaderMutex;      // held by the current leader while in epoll_wait
+    std::atomic<size_t> activeWorkers;
     
-    std::atomic<int> waitingFollowers;
-    std::thread::id currentLeader;
-    std::mutex leaderMutex;
+    // Open connections by socket
+    std::unordered_map<int, std::shared_ptr<ClientConnection>> connections;
+    std::mutex connectionsMutex;
+    
+    // Pipelined requests, picked up by whichever worker is leader when
+    // workFd becomes readable; each push is followed by one workFd count
+    MPMCQueue<PipelinedRequest> pendingWork;
     
     // Statistics
     std::atomic<long long> totalRequestsProcessed;
     std::atomic<long long> leaderPromotions;
     std::atomic<long long> totalProcessingTime; // microseconds
+    std::atomic<long long> pipelinedRequests;
     std::mutex logMutex;
     
 public:
-    LFServer(int serverPort, size_t numWorkers = 4);
+    // A cacheBytes of 0 disables the result cache
+    LFServer(int serverPort, size_t numWorkers = 4,
+             AlgorithmRunner::Mode mode = AlgorithmRunner::Mode::FAN_OUT,
+             size_t cacheBytes = ResultCache::DEFAULT_BYTE_BUDGET);
     ~LFServer();
     
     void start();
@@ -61,23 +121,56 @@ public:
     void printStatistics() const;
     
 private:
+    // A pipelined connection beyond this many outstanding requests has the
+    // reading worker run the next one itself, which also stops it reading
+    static const int MAX_IN_FLIGHT = 64;
+    
+    // Pipelined requests estimated below this many steps (see
+    // AlgorithmRunner::estimateCost) are answered by the reading worker:
+    // handing them off would cost more than running them
+    static constexpr double INLINE_COST = 1e5;
+    
+    // A connection with more unsent output than this is not read until half
+    // of it has gone out
+    static const size_t MAX_OUTPUT_BACKLOG = 1 << 20;
+    
+    // Pipelined requests queued across all connections; when full, the
+    // reading worker runs the request itself
+    static const size_t PENDING_WORK_CAPACITY = 4096;
+    
     // Server management
-    void setupSocket();
+    void setupEventLoop();
     void acceptClients();
-    void handleNewClient(int clientSocket, int clientId);
+    std::string welcomeMessage(int clientId) const;
     
     // Leader-Follower implementation
     void workerThread();
-    void promoteNewLeader();
-    bool becomeLeader();
-    void processRequest(std::shared_ptr<ClientRequest> request);
+    void handleEvent(int fd, uint32_t events);
+    bool readClient(const std::shared_ptr<ClientConnection>& connection);
+    bool handleRequests(const std::shared_ptr<ClientConnection>& connection);
+    bool handleLine(ClientConnection& connection, uint64_t requestId, const std::string& input);
+    bool handleGraph(const std::shared_ptr<ClientConnection>& connection, uint64_t requestId,
+                     StreamMessage& request);
+    void runPendingWork();
+    std::string answerGraph(const StreamMessage& request, uint64_t requestId, int clientId);
+    std::string answerBatch(const StreamMessage& batch, int clientId);
+    void rearmAccept();
+    void closeClient(int fd);
+    bool sendReply(ClientConnection& connection, uint64_t requestId, const std::string& reply);
+    bool flushOutput(ClientConnection& connection);
+    void updateInterest(ClientConnection& connection, bool force = false);
+    void processRequest(ClientConnection& connection, std::shared_ptr<ClientRequest> request);
     
     // Request processing
     std::string parseAndExecuteAlgorithms(const std::string& input, int clientId);
+    std::string formatEstimates(AlgorithmRunner::Mask mask, int vertices, int edges);
+    static AlgorithmRunner::Mask parseHead(std::istream& input, int& vertices, int& edges);
+    static AlgorithmRunner::Mask requestMask(const StreamMessage& request);
+    static double estimateCost(const StreamMessage& request);
+    std::string analyzeGraph(const StreamMessage& request, AlgorithmRunner::Mask mask, int clientId,
+                             AlgorithmRunner::Mode mode);
     Graph parseGraph(const std::string& input, const std::string& algorithmName);
-    std::string formatResponse(const std::vector<AlgorithmResult>& results, int clientId, 
-                             long long totalTime);
-    std::string formatError(const std::string& error, int clientId = -1);
+    static std::string withPrompt(const std::string& text, uint64_t requestId);
     
     // Utilities
     void log(const std::string& message);
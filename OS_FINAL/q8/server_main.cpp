@@ -13,22 +13,29 @@ void signalHandler(int signal) {
 
 void printUsage(const char* progName) {
     std::cout << "=== Q8: Leader-Follower Server ===" << std::endl;
-    std::cout << "Usage: " << progName << " [port] [workers]" << std::endl;
+    std::cout << "Usage: " << progName << " [port] [workers] [mode] [cache_mb]" << std::endl;
     std::cout << "  port:    TCP port (default: 8080)" << std::endl;
     std::cout << "  workers: Number of worker threads (default: 4)" << std::endl;
+    std::cout << "  mode:    fanout - run a request's algorithms concurrently (default)" << std::endl;
+    std::cout << "           serial - one after another, for throughput-bound loads" << std::endl;
+    std::cout << "  cache_mb: Result cache budget in MB, 0 disables it (default: 16)" << std::endl;
     std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "  " << progName << "          # port 8080, 4 workers" << std::endl;
     std::cout << "  " << progName << " 9000     # port 9000, 4 workers" << std::endl;
     std::cout << "  " << progName << " 8080 8   # port 8080, 8 workers" << std::endl;
+    std::cout << "  " << progName << " 8080 8 serial  # no intra-request fan-out" << std::endl;
+    std::cout << "  " << progName << " 8080 8 fanout 0  # no result cache" << std::endl;
 }
 
 int main(int argc, char* argv[]) {
     int port = 8080;
     size_t numWorkers = 4;
+    AlgorithmRunner::Mode mode = AlgorithmRunner::Mode::FAN_OUT;
+    size_t cacheBytes = ResultCache::DEFAULT_BYTE_BUDGET;
     
     // Parse arguments
-    if (argc > 3) {
+    if (argc > 5) {
         std::cerr << "Too many arguments" << std::endl;
         printUsage(argv[0]);
         return 1;
@@ -53,7 +60,7 @@ int main(int argc, char* argv[]) {
         }
     }
     
-    if (argc == 3) {
+    if (argc >= 3) {
         try {
             numWorkers = std::stoi(argv[2]);
             if (numWorkers < 1 || numWorkers > 16) {
@@ -66,17 +73,43 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (argc >= 4) {
+        try {
+            mode = AlgorithmRunner::stringToMode(argv[3]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (argc == 5) {
+        try {
+            int megabytes = std::stoi(argv[4]);
+            if (megabytes < 0 || megabytes > 4096) {
+                std::cerr << "Cache size must be 0-4096 MB" << std::endl;
+                return 1;
+            }
+            cacheBytes = static_cast<size_t>(megabytes) << 20;
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid cache size: " << argv[4] << std::endl;
+            return 1;
+        }
+    }
+    
     try {
         // Setup signal handling
         signal(SIGINT, signalHandler);
         signal(SIGTERM, signalHandler);
         
-        LFServer server(port, numWorkers);
+        LFServer server(port, numWorkers, mode, cacheBytes);
         globalServer = &server;
         
         std::cout << "=== Q8: Leader-Follower Algorithms Server ===" << std::endl;
         std::cout << "Port: " << port << std::endl;
         std::cout << "Worker threads: " << numWorkers << std::endl;
+        std::cout << "Algorithm execution: " << AlgorithmRunner::modeToString(mode) << std::endl;
+        std::cout << "Result cache: " << (cacheBytes > 0 ? std::to_string(cacheBytes >> 20) + " MB" : "disabled")
+                  << std::endl;
         std::cout << "Pattern: Leader-Follower" << std::endl;
         std::cout << "=============================================" << std::endl;
         
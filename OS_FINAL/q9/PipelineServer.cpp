@@ -0,0 +1,588 @@
+#include "PipelineServer.h"
+#include "../servers/ServerSupport.h"
+#include "../common/BinaryProtocol.h"
+#include <iostream>
+#include <sstream>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+
+PipelineConnection::~PipelineConnection() {
+    close(clientSocket);
+}
+
+PipelineServer::PipelineServer(int serverPort, size_t queueCapacity, AlgorithmRunner::Mode mode,
+                               size_t cacheBytes)
+    : port(serverPort), running(false), serverSocket(-1), epollFd(-1), wakeupFd(-1), clientCounter(0),
+      algorithmMode(mode), openConnections(0), totalRequestsProcessed(0), totalLatency(0), maxLatency(0) {
+
+    if (cacheBytes > 0) {
+        resultCache = std::make_unique<ResultCache>(cacheBytes);
+    }
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        stages.push_back(std::make_unique<ActiveObject>(stageName(stage), queueCapacity));
+    }
+
+    log("Pipeline server created with " + std::to_string(STAGE_COUNT) + " stages, queue capacity " +
+        std::to_string(queueCapacity) + ", " + AlgorithmRunner::modeToString(mode) + " algorithm execution, " +
+        (cacheBytes > 0 ? std::to_string(cacheBytes) + " byte result cache" : "no result cache"));
+}
+
+PipelineServer::~PipelineServer() {
+    stop();
+}
+
+const char* PipelineServer::stageName(int stage) {
+    switch (stage) {
+        case PARSE: return "parse";
+        case BUILD: return "build";
+        case EXECUTE: return "execute";
+        case FORMAT: return "format";
+        case SEND: return "send";
+        default: return "unknown";
+    }
+}
+
+void PipelineServer::start() {
+    if (running) {
+        log("Server already running");
+        return;
+    }
+
+    try {
+        serverSocket = ServerSupport::openListeningSocket(port);
+        setupEventLoop();
+        running = true;
+
+        // Downstream stages first, so nothing is ever queued to a stopped one
+        for (int stage = STAGE_COUNT - 1; stage >= 0; --stage) {
+            stages[stage]->start();
+        }
+        readerThread = std::thread(&PipelineServer::readerLoop, this);
+
+        log("=== Pipeline Server Started ===");
+        log("Port: " + std::to_string(port));
+        log("Stages: parse -> build -> execute -> format -> send");
+        log("Protocol: Multi-algorithm requests (newline framed)");
+        log("Pattern: Pipeline of Active Objects");
+        log("===============================");
+
+    } catch (const std::exception& e) {
+        log("Failed to start server: " + std::string(e.what()));
+        stop();
+        throw;
+    }
+}
+
+void PipelineServer::stop() {
+    bool wasRunning = running.exchange(false);
+
+    // Stop feeding the pipeline first
+    if (wakeupFd >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeupFd, &one, sizeof(one));
+        (void)ignored;
+    }
+    if (readerThread.joinable()) {
+        readerThread.join();
+    }
+
+    // Each stage drains into the next one, which is still running
+    for (auto& stage : stages) {
+        stage->stop();
+    }
+
+    // Requests are done with their connections; this closes the sockets
+    connections.clear();
+    openConnections = 0;
+
+    if (serverSocket >= 0) {
+        close(serverSocket);
+        serverSocket = -1;
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeupFd >= 0) {
+        close(wakeupFd);
+        wakeupFd = -1;
+    }
+
+    if (wasRunning) {
+        log("=== Pipeline Server Stopped ===");
+    }
+}
+
+void PipelineServer::setupEventLoop() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        throw std::runtime_error("Failed to create epoll instance");
+    }
+
+    wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeupFd < 0) {
+        throw std::runtime_error("Failed to create wakeup eventfd");
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = wakeupFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeupFd, &event) < 0) {
+        throw std::runtime_error("Failed to register wakeup eventfd");
+    }
+
+    event.data.fd = serverSocket;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, serverSocket, &event) < 0) {
+        throw std::runtime_error("Failed to register server socket");
+    }
+}
+
+std::string PipelineServer::welcomeMessage(int clientId) const {
+    return
+        "=== Pipeline Algorithms Server ===\n"
+        "Client ID: " + std::to_string(clientId) + "\n"
+        "Format: vertices edges edge1 edge2 ...\n"
+        "Edge format: u-v or weighted u-v:w (weights are used by mst)\n"
+        "All algorithms will be executed: euler, clique, mst, hamilton, scc\n"
+        "\n"
+        "Examples:\n"
+        "  3 3 0-1 1-2 2-0    (triangle - works for most algorithms)\n"
+        "  4 4 0-1 1-2 2-3 3-0  (square - good test case)\n"
+        "\n"
+        "Commands: help, stats, quit\n"
+        "Binary GBIN frames are accepted too (algorithm mask, packed edges)\n"
+        "> ";
+}
+
+void PipelineServer::readerLoop() {
+    struct epoll_event events[64];
+
+    while (running) {
+        int ready = epoll_wait(epollFd, events, 64, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            log("epoll_wait failed: " + std::string(strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < ready && running; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeupFd) {
+                continue;
+            } else if (fd == serverSocket) {
+                acceptClients();
+            } else {
+                handleClientEvent(fd, events[i].events);
+            }
+        }
+    }
+}
+
+void PipelineServer::acceptClients() {
+    while (running) {
+        struct sockaddr_in clientAddr;
+        socklen_t clientLen = sizeof(clientAddr);
+
+        int clientSocket = accept4(serverSocket, (struct sockaddr*)&clientAddr, &clientLen,
+                                   SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientSocket < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                log("Failed to accept client connection: " + std::string(strerror(errno)));
+            }
+            break;
+        }
+
+        int clientId = ++clientCounter;
+        auto connection = std::make_shared<PipelineConnection>(clientSocket, clientId);
+        logRequest(clientId, "Connected from " + std::string(inet_ntoa(clientAddr.sin_addr)));
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = clientSocket;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientSocket, &event) < 0) {
+            logRequest(clientId, "Failed to register with epoll");
+            continue;
+        }
+        connection->armedEvents = event.events;
+        connections[clientSocket] = connection;
+        openConnections = connections.size();
+
+        // Nothing of this client is in the pipeline yet, so the welcome
+        // text cannot overtake a reply
+        std::lock_guard<std::mutex> lock(connection->outputMutex);
+        connection->outputBuffer = welcomeMessage(clientId);
+        flushOutput(*connection);
+    }
+}
+
+void PipelineServer::handleClientEvent(int fd, uint32_t events) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    std::shared_ptr<PipelineConnection> connection = it->second;
+
+    // Also reported once the socket was shut down after its last reply
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        closeClient(fd);
+        return;
+    }
+    if (events & EPOLLOUT) {
+        std::lock_guard<std::mutex> lock(connection->outputMutex);
+        flushOutput(*connection);
+    }
+    if (events & (EPOLLIN | EPOLLRDHUP)) {
+        readClient(connection);
+    }
+}
+
+void PipelineServer::readClient(const std::shared_ptr<PipelineConnection>& connection) {
+    {
+        // The interest may have changed after this event was reported
+        std::lock_guard<std::mutex> lock(connection->outputMutex);
+        if (connection->readingDone || connection->throttled || connection->shutDown) return;
+    }
+
+    // Level-triggered: one read per wakeup keeps busy clients from starving others
+    char buffer[16384];
+    ssize_t bytesRead = recv(connection->clientSocket, buffer, sizeof(buffer), 0);
+    if (bytesRead < 0) {
+        if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) return;
+        logRequest(connection->clientId, "Receive error: " + std::string(strerror(errno)));
+        closeClient(connection->clientSocket);
+        return;
+    }
+    if (bytesRead == 0) {
+        // Replies still in the pipeline are sent before the socket closes
+        logRequest(connection->clientId, "Disconnected");
+        stopReading(*connection);
+        return;
+    }
+
+    RequestStream& requests = connection->requests;
+    requests.append(buffer, bytesRead);
+
+    StreamMessage message;
+    while (requests.next(message)) {
+        if (message.kind != StreamMessage::Kind::LINE) {
+            handleGraph(connection, message);
+            continue;
+        }
+
+        bool closeAfterReply = false;
+        handleLine(connection, message.text, closeAfterReply);
+        if (closeAfterReply) {
+            // The goodbye is queued; the socket closes once it is sent
+            stopReading(*connection);
+            return;
+        }
+    }
+
+    // A broken frame header or an endless line leaves no way to find the next request
+    if (requests.failed()) {
+        auto request = std::make_shared<PipelineRequest>(connection, "", requests.failedInFrame());
+        request->response = requests.failedInFrame()
+                                ? BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR, requests.failure())
+                                : ServerSupport::formatError(requests.failure(), connection->clientId) + "\n";
+        request->done = true;
+        submit(std::move(request));
+        stopReading(*connection);
+    }
+}
+
+void PipelineServer::stopReading(PipelineConnection& connection) {
+    std::lock_guard<std::mutex> lock(connection.outputMutex);
+    connection.readingDone = true;
+    flushOutput(connection);
+}
+
+void PipelineServer::closeClient(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    {
+        // Replies still in the pipeline are dropped from here on
+        std::lock_guard<std::mutex> lock(it->second->outputMutex);
+        it->second->closed = true;
+        it->second->outputBuffer.clear();
+    }
+    // The socket itself is closed by the last request holding the connection
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    connections.erase(it);
+    openConnections = connections.size();
+}
+
+void PipelineServer::handleLine(const std::shared_ptr<PipelineConnection>& connection, const std::string& input,
+                                bool& closeAfterReply) {
+    auto request = std::make_shared<PipelineRequest>(connection, input);
+
+    // Commands are answered right away but still travel the whole pipeline,
+    // so they cannot overtake earlier requests of the same client
+    if (input == "quit" || input == "exit") {
+        request->response = "Goodbye!\n";
+        request->done = true;
+        closeAfterReply = true;
+    } else if (input == "help") {
+        request->response = welcomeMessage(connection->clientId);
+        request->done = true;
+    } else if (input == "stats") {
+        request->response = formatStatistics() + "> ";
+        request->done = true;
+    } else if (input.empty()) {
+        request->response = "Empty input. Type 'help' for usage.\n> ";
+        request->done = true;
+    }
+
+    submit(std::move(request));
+}
+
+void PipelineServer::handleGraph(const std::shared_ptr<PipelineConnection>& connection, StreamMessage& message) {
+    // Already parsed while it arrived; the parse stage only checks the result
+    bool binary = (message.kind != StreamMessage::Kind::GRAPH);
+    auto request = std::make_shared<PipelineRequest>(connection, "", binary);
+    if (message.kind == StreamMessage::Kind::BATCH) {
+        request->response = BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR,
+                                                           "Batch frames are not supported by the pipeline server");
+        request->done = true;
+        submit(std::move(request));
+        return;
+    }
+    request->parsed = true;
+    request->vertices = message.vertices;
+    request->declaredEdges = message.edgeCount;
+    request->edges = std::move(message.edges);
+    request->parseError = std::move(message.error);
+    if (binary) {
+        request->algorithmMask = message.algorithmMask;
+    }
+    submit(std::move(request));
+}
+
+void PipelineServer::submit(std::shared_ptr<PipelineRequest> request) {
+    {
+        // Counted before it can reach the send stage
+        std::lock_guard<std::mutex> lock(request->connection->outputMutex);
+        request->connection->pendingReplies++;
+    }
+    dispatch(std::move(request), PARSE);
+}
+
+void PipelineServer::dispatch(std::shared_ptr<PipelineRequest> request, int stage) {
+    // Blocks while the stage queue is full: back-pressure on the stage before
+    stages[stage]->enqueue([this, request, stage]() {
+        runStage(stage, *request);
+        if (stage + 1 < STAGE_COUNT) {
+            dispatch(request, stage + 1);
+        }
+    });
+}
+
+void PipelineServer::runStage(int stage, PipelineRequest& request) {
+    if (stage == SEND) {
+        sendResponse(request);
+        return;
+    }
+    if (request.done) {
+        return;
+    }
+
+    try {
+        switch (stage) {
+            case PARSE: parseRequest(request); break;
+            case BUILD: buildGraphs(request); break;
+            case EXECUTE: executeAlgorithms(request); break;
+            case FORMAT: formatResponse(request); break;
+        }
+    } catch (const std::exception& e) {
+        std::string error = ServerSupport::formatError(e.what(), request.connection->clientId);
+        request.response = request.binary ? BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR, error)
+                                          : error + "\n> ";
+        request.done = true;
+        logRequest(request.connection->clientId, "Error: " + std::string(e.what()));
+    }
+}
+
+void PipelineServer::parseRequest(PipelineRequest& request) {
+    if (request.parsed) {
+        if (!request.parseError.empty()) {
+            throw std::invalid_argument(request.parseError);
+        }
+        if (static_cast<int>(request.edges.size()) != request.declaredEdges) {
+            throw std::invalid_argument("Edge count mismatch");
+        }
+        return;
+    }
+
+    std::istringstream iss(request.input);
+    int edgeCount;
+
+    if (!(iss >> request.vertices)) {
+        throw std::invalid_argument("Missing vertices count");
+    }
+    if (!(iss >> edgeCount)) {
+        throw std::invalid_argument("Missing edges count");
+    }
+    if (edgeCount < 0) {
+        throw std::invalid_argument("Edge count mismatch");
+    }
+
+    std::string edgeStr;
+    while (static_cast<int>(request.edges.size()) < edgeCount && iss >> edgeStr) {
+        request.edges.push_back(parseEdgeToken(edgeStr));
+    }
+
+    if (static_cast<int>(request.edges.size()) != edgeCount) {
+        throw std::invalid_argument("Edge count mismatch");
+    }
+}
+
+void PipelineServer::buildGraphs(PipelineRequest& request) {
+    ServerSupport::buildGraphs(request.vertices, request.edges, request.undirectedGraph, request.directedGraph);
+}
+
+void PipelineServer::executeAlgorithms(PipelineRequest& request) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    request.results = AlgorithmRunner::runAll(*request.undirectedGraph, *request.directedGraph, algorithmMode,
+                                              resultCache.get(), request.algorithmMask);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    request.executionMillis = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    // The graphs are not needed past this stage
+    request.undirectedGraph.reset();
+    request.directedGraph.reset();
+}
+
+void PipelineServer::formatResponse(PipelineRequest& request) {
+    std::string response = ServerSupport::formatAnalysis(request.results, request.connection->clientId,
+                                                         request.executionMillis);
+    request.response = request.binary ? BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_OK, response)
+                                      : response + "\n> ";
+    request.done = true;
+}
+
+void PipelineServer::sendResponse(PipelineRequest& request) {
+    {
+        // Never blocks: what the socket does not take now waits for EPOLLOUT
+        PipelineConnection& connection = *request.connection;
+        std::lock_guard<std::mutex> lock(connection.outputMutex);
+        connection.pendingReplies--;
+        if (!connection.closed && !connection.shutDown) {
+            connection.outputBuffer += request.response;
+        }
+        flushOutput(connection);
+    }
+
+    long long latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - request.received).count();
+    totalLatency += latency;
+    long long longest = maxLatency.load();
+    while (latency > longest && !maxLatency.compare_exchange_weak(longest, latency)) {
+    }
+    totalRequestsProcessed++;
+}
+
+void PipelineServer::flushOutput(PipelineConnection& connection) {
+    if (connection.closed || connection.shutDown) {
+        return;
+    }
+    if (!ServerSupport::sendPending(connection.clientSocket, connection.outputBuffer)) {
+        // The client may have part of a reply; end the connection rather
+        // than send anything after it
+        connection.outputBuffer.clear();
+        connection.shutDown = true;
+    } else if (connection.readingDone && connection.pendingReplies == 0 && connection.outputBuffer.empty()) {
+        connection.shutDown = true;
+    }
+    if (connection.shutDown) {
+        // The reader sees the hang-up and closes the connection
+        shutdown(connection.clientSocket, SHUT_RDWR);
+    }
+
+    // Stop reading above the limit, resume below half of it
+    size_t backlog = connection.outputBuffer.size();
+    connection.throttled = backlog > (connection.throttled ? MAX_OUTPUT_BACKLOG / 2 : MAX_OUTPUT_BACKLOG);
+    updateInterest(connection);
+}
+
+void PipelineServer::updateInterest(PipelineConnection& connection) {
+    if (connection.closed) {
+        return;
+    }
+    uint32_t events = 0;
+    if (!connection.readingDone && !connection.throttled && !connection.shutDown) {
+        events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (!connection.outputBuffer.empty()) {
+        events |= EPOLLOUT;
+    }
+    if (events == connection.armedEvents) {
+        return;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.fd = connection.clientSocket;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.clientSocket, &event);
+    connection.armedEvents = events;
+}
+
+std::vector<ActiveObjectStats> PipelineServer::getStageStats() const {
+    std::vector<ActiveObjectStats> result;
+    for (const auto& stage : stages) {
+        result.push_back(stage->getStats());
+    }
+    return result;
+}
+
+std::string PipelineServer::formatStatistics() const {
+    long long completed = totalRequestsProcessed;
+
+    std::ostringstream stats;
+    stats << "\n=== Pipeline Statistics ===\n";
+    stats << "Requests completed: " << completed << "\n";
+    stats << "Average latency: " << (completed > 0 ? totalLatency / completed : 0) << "μs"
+          << " (max " << maxLatency << "μs)\n";
+    stats << "Open connections: " << openConnections << "\n";
+    stats << "Algorithm execution: " << AlgorithmRunner::modeToString(algorithmMode) << "\n";
+    stats << (resultCache ? resultCache->formatStats() : "Result cache: disabled\n");
+    stats << std::left << std::setw(9) << "Stage" << std::right
+          << std::setw(7) << "Depth" << std::setw(7) << "Max" << std::setw(7) << "Cap"
+          << std::setw(11) << "Processed" << std::setw(12) << "Wait (μs)" << std::setw(15) << "Service (μs)" << "\n";
+    for (const auto& stage : getStageStats()) {
+        stats << std::left << std::setw(9) << stage.name << std::right
+              << std::setw(7) << stage.queueDepth << std::setw(7) << stage.maxQueueDepth
+              << std::setw(7) << stage.queueCapacity << std::setw(11) << stage.processed
+              << std::fixed << std::setprecision(1)
+              << std::setw(11) << stage.averageWaitMicros << std::setw(14) << stage.averageServiceMicros << "\n";
+    }
+    stats << "===========================\n";
+    return stats.str();
+}
+
+void PipelineServer::log(const std::string& message) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    auto tm = *std::localtime(&time_t);
+
+    std::cout << std::put_time(&tm, "[%H:%M:%S] ") << message << std::endl;
+}
+
+void PipelineServer::logRequest(int clientId, const std::string& activity) {
+    log("Client " + std::to_string(clientId) + ": " + activity);
+}
+
+void PipelineServer::printStatistics() const {
+    std::cout << "\n=== Pipeline Server Statistics ===" << std::endl;
+    std::cout << formatStatistics();
+}
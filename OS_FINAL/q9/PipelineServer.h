@@ -0,0 +1,175 @@
+#ifndef PIPELINE_SERVER_H
+#define PIPELINE_SERVER_H
+
+#include "../common/Graph.h"
+#include "../common/RequestStream.h"
+#include "../algorithms/AlgorithmFactory.h"
+#include "../algorithms/AlgorithmRunner.h"
+#include "../threading/ActiveObject.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// One connected client. The socket is closed when the last reference goes
+// away, so a request still in the pipeline can never write to a descriptor
+// that was reused by a newer connection.
+//
+// Replies are queued in outputBuffer and written without blocking, by the
+// send stage and, for what the socket did not take, by the reader on
+// EPOLLOUT. Once reading is done (quit, end of input, broken stream) the
+// socket is shut down after the last reply leaves, and the reader closes
+// the connection on the hang-up.
+struct PipelineConnection {
+    int clientSocket;
+    int clientId;
+    RequestStream requests;      // bytes received after the last complete request (reader thread only)
+
+    // Guarded by outputMutex
+    std::mutex outputMutex;
+    std::string outputBuffer;    // replies the socket has not taken yet
+    int pendingReplies;          // requests in the pipeline, not yet queued for sending
+    uint32_t armedEvents;        // interest last registered with epoll
+    bool throttled;              // too much unsent output: not reading
+    bool readingDone;            // no more requests are read from this client
+    bool shutDown;               // socket shut down; the reader closes it on the hang-up
+    bool closed;                 // no longer in the epoll set
+
+    PipelineConnection(int socket, int id)
+        : clientSocket(socket), clientId(id), requests(RequestStream::GraphLines::COUNTS), pendingReplies(0),
+          armedEvents(0), throttled(false), readingDone(false), shutDown(false), closed(false) {}
+    ~PipelineConnection();
+};
+
+// A request travelling through the pipeline. Each stage fills in its part;
+// once a stage fails (or the reply is known up front, e.g. for "stats")
+// 'done' is set and the remaining stages only pass it along, so replies
+// still leave in request order.
+struct PipelineRequest {
+    std::shared_ptr<PipelineConnection> connection;
+    std::string input;           // text line, unless the reader already parsed the request
+    std::chrono::steady_clock::time_point received;
+    bool binary;                 // reply with a response frame instead of text
+    bool done;
+
+    // parse (done by the reader for graph lines and frames; see 'parsed')
+    bool parsed;
+    int vertices;
+    int declaredEdges;
+    std::vector<EdgeToken> edges;
+    std::string parseError;
+    AlgorithmRunner::Mask algorithmMask;
+
+    // build
+    std::unique_ptr<Graph> undirectedGraph;
+    std::unique_ptr<Graph> directedGraph;
+
+    // execute
+    std::vector<AlgorithmResult> results;
+    long long executionMillis;
+
+    // format
+    std::string response;
+
+    PipelineRequest(std::shared_ptr<PipelineConnection> connection, const std::string& input, bool binary = false)
+        : connection(std::move(connection)), input(input), received(std::chrono::steady_clock::now()),
+          binary(binary), done(false), parsed(false), vertices(0), declaredEdges(0),
+          algorithmMask(AlgorithmRunner::ALL_ALGORITHMS), executionMillis(0) {}
+};
+
+// Pipes-and-Filters server: every request flows through a chain of Active
+// Objects (parse -> build graph -> run algorithms -> format -> send), each
+// with its own thread and bounded queue, so consecutive requests overlap
+// across stages. One epoll reader thread splits the input into requests
+// (see RequestStream.h) and feeds the chain; a full stage queue blocks the
+// stage before it, down to the reader. The send stage never blocks on a
+// client: a slow reader only stops its own connection from being read.
+class PipelineServer {
+public:
+    enum Stage { PARSE, BUILD, EXECUTE, FORMAT, SEND, STAGE_COUNT };
+
+    // FAN_OUT spreads a request's algorithms over the shared thread pool, so
+    // the execute stage - usually the slowest - holds each request only as
+    // long as its slowest algorithm. A cacheBytes of 0 disables the result cache.
+    PipelineServer(int serverPort, size_t queueCapacity = 256,
+                   AlgorithmRunner::Mode mode = AlgorithmRunner::Mode::FAN_OUT,
+                   size_t cacheBytes = ResultCache::DEFAULT_BYTE_BUDGET);
+    ~PipelineServer();
+
+    void start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    std::vector<ActiveObjectStats> getStageStats() const;
+    void printStatistics() const;
+
+private:
+    // A connection whose unsent replies pass this many bytes is not read
+    // until they drain below half of it
+    static const size_t MAX_OUTPUT_BACKLOG = 1 << 20;
+
+    // Server basics
+    int port;
+    std::atomic<bool> running;
+    int serverSocket;
+    int epollFd;
+    int wakeupFd;                // eventfd: wakes the reader on stop()
+    int clientCounter;
+    AlgorithmRunner::Mode algorithmMode;
+    std::unique_ptr<ResultCache> resultCache;   // null when caching is disabled
+    std::thread readerThread;
+
+    // Open connections by socket (reader thread only)
+    std::unordered_map<int, std::shared_ptr<PipelineConnection>> connections;
+    std::atomic<size_t> openConnections;
+
+    // One Active Object per stage
+    std::vector<std::unique_ptr<ActiveObject>> stages;
+
+    // Statistics
+    std::atomic<long long> totalRequestsProcessed;
+    std::atomic<long long> totalLatency;        // microseconds, receive -> sent
+    std::atomic<long long> maxLatency;
+    std::mutex logMutex;
+
+    // Server management
+    void setupEventLoop();
+    void readerLoop();
+    void acceptClients();
+    void handleClientEvent(int fd, uint32_t events);
+    void readClient(const std::shared_ptr<PipelineConnection>& connection);
+    void stopReading(PipelineConnection& connection);
+    void closeClient(int fd);
+    std::string welcomeMessage(int clientId) const;
+
+    // Pipeline
+    void handleLine(const std::shared_ptr<PipelineConnection>& connection, const std::string& input,
+                    bool& closeAfterReply);
+    void handleGraph(const std::shared_ptr<PipelineConnection>& connection, StreamMessage& message);
+    void submit(std::shared_ptr<PipelineRequest> request);
+    void dispatch(std::shared_ptr<PipelineRequest> request, int stage);
+    void runStage(int stage, PipelineRequest& request);
+
+    // Stages
+    void parseRequest(PipelineRequest& request);
+    void buildGraphs(PipelineRequest& request);
+    void executeAlgorithms(PipelineRequest& request);
+    void formatResponse(PipelineRequest& request);
+    void sendResponse(PipelineRequest& request);
+
+    // Output (callers hold the connection's outputMutex)
+    void flushOutput(PipelineConnection& connection);
+    void updateInterest(PipelineConnection& connection);
+
+    // Utilities
+    std::string formatStatistics() const;
+    void log(const std::string& message);
+    void logRequest(int clientId, const std::string& activity);
+
+    static const char* stageName(int stage);
+};
+
+#endif
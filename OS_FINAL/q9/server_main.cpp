@@ -0,0 +1,141 @@
+#include "PipelineServer.h"
+#include <iostream>
+#include <csignal>
+
+PipelineServer* globalServer = nullptr;
+
+void signalHandler(int signal) {
+    std::cout << "\nReceived signal " << signal << ". Shutting down..." << std::endl;
+    if (globalServer) {
+        globalServer->stop();
+    }
+}
+
+void printUsage(const char* progName) {
+    std::cout << "=== Q9: Pipeline Server ===" << std::endl;
+    std::cout << "Usage: " << progName << " [port] [queue_capacity] [mode] [cache_mb]" << std::endl;
+    std::cout << "  port:           TCP port (default: 8080)" << std::endl;
+    std::cout << "  queue_capacity: Bounded queue size of every stage (default: 256)" << std::endl;
+    std::cout << "  mode:           fanout - run a request's algorithms concurrently (default)" << std::endl;
+    std::cout << "                  serial - one after another, for throughput-bound loads" << std::endl;
+    std::cout << "  cache_mb:       Result cache budget in MB, 0 disables it (default: 16)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Examples:" << std::endl;
+    std::cout << "  " << progName << "            # port 8080, queues of 256" << std::endl;
+    std::cout << "  " << progName << " 9000       # port 9000, queues of 256" << std::endl;
+    std::cout << "  " << progName << " 8080 1024  # port 8080, queues of 1024" << std::endl;
+    std::cout << "  " << progName << " 8080 256 serial  # no intra-request fan-out" << std::endl;
+    std::cout << "  " << progName << " 8080 256 fanout 64  # 64 MB result cache" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int port = 8080;
+    size_t queueCapacity = 256;
+    AlgorithmRunner::Mode mode = AlgorithmRunner::Mode::FAN_OUT;
+    size_t cacheBytes = ResultCache::DEFAULT_BYTE_BUDGET;
+    
+    // Parse arguments
+    if (argc > 5) {
+        std::cerr << "Too many arguments" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    if (argc >= 2) {
+        std::string arg1 = argv[1];
+        if (arg1 == "-h" || arg1 == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        
+        try {
+            port = std::stoi(arg1);
+            if (port < 1024 || port > 65535) {
+                std::cerr << "Port must be 1024-65535" << std::endl;
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid port: " << arg1 << std::endl;
+            return 1;
+        }
+    }
+    
+    if (argc >= 3) {
+        try {
+            int capacity = std::stoi(argv[2]);
+            if (capacity < 1 || capacity > 65536) {
+                std::cerr << "Queue capacity must be 1-65536" << std::endl;
+                return 1;
+            }
+            queueCapacity = capacity;
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid queue capacity: " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    
+    if (argc >= 4) {
+        try {
+            mode = AlgorithmRunner::stringToMode(argv[3]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (argc == 5) {
+        try {
+            int megabytes = std::stoi(argv[4]);
+            if (megabytes < 0 || megabytes > 4096) {
+                std::cerr << "Cache size must be 0-4096 MB" << std::endl;
+                return 1;
+            }
+            cacheBytes = static_cast<size_t>(megabytes) << 20;
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid cache size: " << argv[4] << std::endl;
+            return 1;
+        }
+    }
+    
+    try {
+        // Setup signal handling
+        signal(SIGINT, signalHandler);
+        signal(SIGTERM, signalHandler);
+        
+        PipelineServer server(port, queueCapacity, mode, cacheBytes);
+        globalServer = &server;
+        
+        std::cout << "=== Q9: Pipeline Algorithms Server ===" << std::endl;
+        std::cout << "Port: " << port << std::endl;
+        std::cout << "Stage queue capacity: " << queueCapacity << std::endl;
+        std::cout << "Algorithm execution: " << AlgorithmRunner::modeToString(mode) << std::endl;
+        std::cout << "Result cache: " << (cacheBytes > 0 ? std::to_string(cacheBytes >> 20) + " MB" : "disabled")
+                  << std::endl;
+        std::cout << "Pattern: Pipeline of Active Objects" << std::endl;
+        std::cout << "======================================" << std::endl;
+        
+        server.start();
+        
+        std::cout << "\nServer running! Connect with:" << std::endl;
+        std::cout << "  telnet localhost " << port << std::endl;
+        std::cout << "  or use: ../bin/q9_client" << std::endl;
+        std::cout << "\nExecutes ALL algorithms on each graph:" << std::endl;
+        std::cout << "  euler, clique, mst, hamilton, scc" << std::endl;
+        std::cout << "\nSend 'stats' for per-stage queue depth and latency." << std::endl;
+        std::cout << "Press Ctrl+C to stop and see statistics." << std::endl;
+        
+        // Keep running
+        while (server.isRunning()) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        
+        // Print final statistics
+        server.printStatistics();
+        
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Server error: " << e.what() << std::endl;
+        return 1;
+    }
+}
\ No newline at end of file
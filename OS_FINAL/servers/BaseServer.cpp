@@ -0,0 +1,1008 @@
+#include "BaseServer.h"
+#include "../common/BinaryProtocol.h"
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <poll.h>
+
+namespace {
+
+// Tags carried in io_uring user data and epoll data:
+// operation kind in the top byte, client id in the low 32 bits
+enum : uint64_t {
+    OP_ACCEPT = 1,
+    OP_RECV = 2,
+    OP_SEND = 3,
+    OP_WAKEUP = 4,
+    OP_CANCEL = 5
+};
+
+inline uint64_t makeTag(uint64_t kind, int clientId) {
+    return (kind << 56) | static_cast<uint32_t>(clientId);
+}
+
+const unsigned RING_ENTRIES = 1024;
+const unsigned BUFFER_COUNT = 512;      // must be a power of two
+const unsigned BUFFER_SIZE = 4096;
+const uint16_t BUFFER_GROUP = 0;
+const int EPOLL_BATCH = 256;
+
+std::string errorString(int error) {
+    return std::string(strerror(error));
+}
+
+}
+
+struct BaseServer::Connection {
+    int clientSocket;
+    int clientId;
+    RequestStream requests;      // bytes received after the last complete request
+    std::string outputBuffer;    // replies not yet handed to the kernel
+    std::string sendBuffer;      // io_uring: bytes owned by the in-flight send
+    size_t sendOffset;
+    int pendingOps;              // io_uring: submissions still referencing this connection
+    bool recvArmed;              // io_uring: a recv is outstanding
+    bool writeBlocked;           // epoll: waiting for EPOLLOUT
+    bool readPaused;             // too much queued: not reading
+    bool busy;                   // a deferred reply is being computed
+    bool closeAfterFlush;
+    bool closing;
+
+    Connection(int socket, int id, RequestStream::GraphLines graphLines)
+        : clientSocket(socket), clientId(id), requests(graphLines), sendOffset(0), pendingOps(0),
+          recvArmed(false), writeBlocked(false), readPaused(false), busy(false),
+          closeAfterFlush(false), closing(false) {}
+
+    // Reply bytes not yet accepted by the kernel
+    size_t backlog() const {
+        return outputBuffer.size() + (sendBuffer.empty() ? 0 : sendBuffer.size() - sendOffset);
+    }
+};
+
+// Minimal io_uring instance driven through the raw system calls.
+// Receives use a provided buffer ring registered with the kernel, so a
+// single multishot recv per connection stays armed for its whole lifetime.
+struct BaseServer::IoUring {
+    int ringFd = -1;
+    void* ringMemory = MAP_FAILED;
+    size_t ringSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqLocalTail = 0;
+    unsigned unsubmitted = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    // The kernel header's flex-array union lays out differently under C++,
+    // so the buffer ring is addressed as a plain io_uring_buf array whose
+    // first entry's resv field doubles as the ring tail.
+    io_uring_buf* bufferRing = static_cast<io_uring_buf*>(MAP_FAILED);
+    size_t bufferRingSize = 0;
+    char* buffers = static_cast<char*>(MAP_FAILED);
+    uint16_t bufferTail = 0;
+
+    bool multishotRecv = true;   // cleared if the kernel rejects multishot recv
+
+    ~IoUring() {
+        if (ringFd >= 0) close(ringFd);
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (ringMemory != MAP_FAILED) munmap(ringMemory, ringSize);
+        if (bufferRing != MAP_FAILED) munmap(bufferRing, bufferRingSize);
+        if (buffers != MAP_FAILED) munmap(buffers, static_cast<size_t>(BUFFER_COUNT) * BUFFER_SIZE);
+    }
+
+    bool setup(std::string& reason) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+        params.cq_entries = RING_ENTRIES * 4;   // multishot ops post many completions per submission
+
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, RING_ENTRIES, &params));
+        if (ringFd < 0) {
+            reason = "io_uring_setup: " + errorString(errno);
+            return false;
+        }
+
+        const unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+        if ((params.features & required) != required) {
+            reason = "kernel lacks required io_uring features";
+            return false;
+        }
+
+        ringSize = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                                    params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        ringMemory = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ringFd, IORING_OFF_SQ_RING);
+        if (ringMemory == MAP_FAILED) {
+            reason = "mmap of io_uring rings: " + errorString(errno);
+            return false;
+        }
+
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                               MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED) {
+            reason = "mmap of submission entries: " + errorString(errno);
+            return false;
+        }
+
+        char* base = static_cast<char*>(ringMemory);
+        sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+        sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+        sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+        sqEntries = params.sq_entries;
+        sqLocalTail = *sqTail;
+
+        cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+        // Provided buffer ring: the kernel picks a buffer for each recv completion
+        bufferRingSize = BUFFER_COUNT * sizeof(io_uring_buf);
+        bufferRing = static_cast<io_uring_buf*>(mmap(nullptr, bufferRingSize, PROT_READ | PROT_WRITE,
+                                                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        buffers = static_cast<char*>(mmap(nullptr, static_cast<size_t>(BUFFER_COUNT) * BUFFER_SIZE,
+                                          PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (bufferRing == MAP_FAILED || buffers == MAP_FAILED) {
+            reason = "buffer allocation: " + errorString(errno);
+            return false;
+        }
+
+        io_uring_buf_reg registration;
+        memset(&registration, 0, sizeof(registration));
+        registration.ring_addr = reinterpret_cast<uint64_t>(bufferRing);
+        registration.ring_entries = BUFFER_COUNT;
+        registration.bgid = BUFFER_GROUP;
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PBUF_RING, &registration, 1) < 0) {
+            reason = "buffer ring registration: " + errorString(errno);
+            return false;
+        }
+
+        for (unsigned i = 0; i < BUFFER_COUNT; ++i) {
+            recycleBuffer(static_cast<uint16_t>(i));
+        }
+        return true;
+    }
+
+    // Next free submission entry, or nullptr when the queue is full
+    io_uring_sqe* nextSqe() {
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (sqLocalTail - head >= sqEntries) {
+            return nullptr;
+        }
+        unsigned index = sqLocalTail & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        sqLocalTail++;
+        unsubmitted++;
+        return sqe;
+    }
+
+    // Next free entry, submitting the queue first if it is full
+    io_uring_sqe* acquireSqe(std::atomic<unsigned long long>& syscalls) {
+        io_uring_sqe* sqe = nextSqe();
+        while (sqe == nullptr) {
+            enter(0);
+            syscalls++;
+            sqe = nextSqe();
+        }
+        return sqe;
+    }
+
+    // Publish queued entries and optionally wait for completions
+    int enter(unsigned minComplete) {
+        __atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+        unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+        int submitted = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, unsubmitted,
+                                                 minComplete, flags, nullptr, 0));
+        if (submitted > 0) {
+            unsubmitted -= std::min<unsigned>(unsubmitted, submitted);
+        }
+        return submitted;
+    }
+
+    void recycleBuffer(uint16_t bufferId) {
+        io_uring_buf* entry = &bufferRing[bufferTail & (BUFFER_COUNT - 1)];
+        entry->addr = reinterpret_cast<uint64_t>(buffers + static_cast<size_t>(bufferId) * BUFFER_SIZE);
+        entry->len = BUFFER_SIZE;
+        entry->bid = bufferId;
+        bufferTail++;
+        __atomic_store_n(&bufferRing[0].resv, bufferTail, __ATOMIC_RELEASE);
+    }
+
+    const char* bufferData(uint16_t bufferId) const {
+        return buffers + static_cast<size_t>(bufferId) * BUFFER_SIZE;
+    }
+};
+
+BaseServer::BaseServer(int serverPort, const std::string& name, IoBackend requestedBackend)
+    : port(serverPort), serverName(name), backend(requestedBackend), running(false),
+      serverSocket(-1), wakeupFd(-1), clientCounter(0), jobs(ThreadPool::shared()),
+      connectionCount(0), ioSyscalls(0), epollFd(-1) {}
+
+BaseServer::~BaseServer() {
+    stop();
+}
+
+void BaseServer::start() {
+    if (running) {
+        return;
+    }
+
+    try {
+        setupSocket();
+
+        wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeupFd < 0) {
+            throw std::runtime_error("Failed to create wakeup eventfd");
+        }
+
+        if (backend != IoBackend::EPOLL) {
+            std::string reason;
+            if (setupIoUring(reason)) {
+                backend = IoBackend::IO_URING;
+            } else {
+                log("io_uring unavailable (" + reason + "), falling back to epoll");
+                ring.reset();
+                backend = IoBackend::EPOLL;
+            }
+        }
+        if (backend == IoBackend::EPOLL) {
+            setupEpoll();
+        }
+    } catch (...) {
+        if (epollFd >= 0) { close(epollFd); epollFd = -1; }
+        if (wakeupFd >= 0) { close(wakeupFd); wakeupFd = -1; }
+        if (serverSocket >= 0) { close(serverSocket); serverSocket = -1; }
+        ring.reset();
+        throw;
+    }
+
+    running = true;
+    log("=== " + serverName + " Started ===");
+    log("Port: " + std::to_string(port));
+    log("I/O backend: " + backendToString(backend));
+    onStart();
+
+    if (backend == IoBackend::IO_URING) {
+        loopThread = std::thread(&BaseServer::runIoUringLoop, this);
+    } else {
+        loopThread = std::thread(&BaseServer::runEpollLoop, this);
+    }
+}
+
+void BaseServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    // Wake the event loop; it closes every connection before returning
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeupFd, &one, sizeof(one));
+    (void)ignored;
+    if (loopThread.joinable()) {
+        loopThread.join();
+    }
+    // Deferred jobs post to wakeupFd, so they finish before it closes
+    jobs.wait();
+    readyReplies.clear();
+
+    ring.reset();
+    if (epollFd >= 0) { close(epollFd); epollFd = -1; }
+    if (wakeupFd >= 0) { close(wakeupFd); wakeupFd = -1; }
+    if (serverSocket >= 0) { close(serverSocket); serverSocket = -1; }
+
+    log("I/O syscalls: " + std::to_string(ioSyscalls.load()));
+    log("=== " + serverName + " Stopped ===");
+}
+
+std::string BaseServer::backendToString(IoBackend backend) {
+    switch (backend) {
+        case IoBackend::AUTO:     return "auto";
+        case IoBackend::IO_URING: return "io_uring";
+        case IoBackend::EPOLL:    return "epoll";
+    }
+    return "unknown";
+}
+
+IoBackend BaseServer::stringToBackend(const std::string& name) {
+    if (name == "auto") return IoBackend::AUTO;
+    if (name == "io_uring" || name == "uring") return IoBackend::IO_URING;
+    if (name == "epoll") return IoBackend::EPOLL;
+    throw std::invalid_argument("Unknown I/O backend: " + name + " (use auto, io_uring or epoll)");
+}
+
+void BaseServer::log(const std::string& message) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    auto tm = *std::localtime(&time_t);
+
+    char timeStr[20];
+    strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &tm);
+
+    std::cout << "[" << timeStr << "] " << message << std::endl;
+}
+
+void BaseServer::setupSocket() {
+    // Allow as many connections as the hard descriptor limit permits
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    serverSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (serverSocket < 0) {
+        throw std::runtime_error("Failed to create socket");
+    }
+
+    int opt = 1;
+    setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+
+    if (bind(serverSocket, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        throw std::runtime_error("Failed to bind to port " + std::to_string(port));
+    }
+    if (listen(serverSocket, SOMAXCONN) < 0) {
+        throw std::runtime_error("Failed to listen on socket");
+    }
+}
+
+bool BaseServer::setupIoUring(std::string& reason) {
+    ring.reset(new IoUring());
+    return ring->setup(reason);
+}
+
+void BaseServer::setupEpoll() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        throw std::runtime_error("Failed to create epoll instance");
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = makeTag(OP_ACCEPT, 0);
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, serverSocket, &event) < 0) {
+        throw std::runtime_error("Failed to register server socket");
+    }
+
+    event.data.u64 = makeTag(OP_WAKEUP, 0);
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeupFd, &event) < 0) {
+        throw std::runtime_error("Failed to register wakeup eventfd");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Connection handling shared by both backends
+// ---------------------------------------------------------------------------
+
+BaseServer::Connection* BaseServer::openConnection(int clientSocket) {
+    int clientId = ++clientCounter;
+    auto connection = std::make_unique<Connection>(clientSocket, clientId, graphLines());
+    Connection* raw = connection.get();
+    connections[clientId] = std::move(connection);
+    connectionCount++;
+
+    struct sockaddr_in peer;
+    socklen_t peerLen = sizeof(peer);
+    std::string clientIP = "unknown";
+    if (getpeername(clientSocket, (struct sockaddr*)&peer, &peerLen) == 0) {
+        clientIP = inet_ntoa(peer.sin_addr);
+    }
+    log("Client " + std::to_string(clientId) + " connected from " + clientIP);
+
+    raw->outputBuffer = welcomeMessage(clientId);
+    return raw;
+}
+
+void BaseServer::onData(Connection& connection, const char* data, size_t length) {
+    if (connection.closing || connection.closeAfterFlush) {
+        return;
+    }
+
+    connection.requests.append(data, length);
+    processRequests(connection);
+}
+
+void BaseServer::processRequests(Connection& connection) {
+    if (connection.closing || connection.closeAfterFlush) {
+        return;
+    }
+    if (connection.busy) {
+        // Requests wait in the stream until the deferred reply arrives
+        updateReading(connection);
+        return;
+    }
+
+    // Requests beyond the backlog limit wait in the stream until replies drain
+    RequestStream& requests = connection.requests;
+    StreamMessage request;
+    bool drained = false;
+    while (true) {
+        if (connection.backlog() > MAX_OUTPUT_BACKLOG) {
+            flush(connection);
+            if (connection.closing || connection.backlog() > MAX_OUTPUT_BACKLOG) {
+                break;
+            }
+        }
+        if (!requests.next(request)) {
+            drained = true;
+            break;
+        }
+        bool closeAfterReply = false;
+        try {
+            switch (request.kind) {
+                case StreamMessage::Kind::LINE:
+                    connection.outputBuffer += handleLine(connection.clientId, request.text, closeAfterReply);
+                    break;
+                case StreamMessage::Kind::GRAPH:
+                    connection.outputBuffer += handleGraph(connection.clientId, request, closeAfterReply);
+                    break;
+                case StreamMessage::Kind::FRAME:
+                    connection.outputBuffer += handleFrame(connection.clientId, request, closeAfterReply);
+                    break;
+                case StreamMessage::Kind::BATCH:
+                    log("Client " + std::to_string(connection.clientId) + " sent a batch frame");
+                    connection.outputBuffer += BinaryProtocol::encodeResponse(
+                        BinaryProtocol::STATUS_ERROR, "Batch frames are not supported by " + serverName);
+                    break;
+            }
+        } catch (const std::exception& e) {
+            log("Client " + std::to_string(connection.clientId) + " error: " + std::string(e.what()));
+            closeAfterReply = true;
+        }
+
+        if (closeAfterReply) {
+            deferredWork = nullptr;
+            connection.closeAfterFlush = true;
+            flush(connection);
+            return;
+        }
+        if (deferredWork) {
+            startDeferred(connection);
+            break;
+        }
+    }
+
+    // A broken frame header or an endless line leaves no way to find the next request
+    if (drained && requests.failed()) {
+        connection.outputBuffer += requests.failedInFrame()
+            ? BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR, requests.failure())
+            : "\n=== ERROR ===\n" + requests.failure() + "\n=============\n";
+        connection.closeAfterFlush = true;
+    }
+
+    flush(connection);
+}
+
+std::string BaseServer::handleGraph(int, const StreamMessage&, bool&) {
+    throw std::logic_error(serverName + " does not parse graph lines");
+}
+
+std::string BaseServer::handleFrame(int clientId, const StreamMessage&, bool&) {
+    log("Client " + std::to_string(clientId) + " sent a binary frame");
+    return BinaryProtocol::encodeResponse(BinaryProtocol::STATUS_ERROR,
+                                          "Binary frames are not supported by " + serverName);
+}
+
+void BaseServer::flush(Connection& connection) {
+    if (connection.closing) {
+        return;
+    }
+
+    if (backend == IoBackend::IO_URING) {
+        // One send in flight per connection keeps replies ordered
+        if (connection.sendBuffer.empty() && !connection.outputBuffer.empty()) {
+            connection.sendBuffer.swap(connection.outputBuffer);
+            connection.sendOffset = 0;
+            submitSend(connection);
+        }
+    } else {
+        size_t sent = 0;
+        std::string& output = connection.outputBuffer;
+        while (sent < output.size()) {
+            ssize_t n = send(connection.clientSocket, output.data() + sent, output.size() - sent,
+                             MSG_NOSIGNAL | MSG_DONTWAIT);
+            ioSyscalls++;
+            if (n > 0) {
+                sent += n;
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            closeConnection(connection);
+            return;
+        }
+        output.erase(0, sent);
+        if (connection.writeBlocked != !output.empty()) {
+            connection.writeBlocked = !output.empty();
+            updateEpollInterest(connection);
+        }
+    }
+
+    if (connection.closeAfterFlush && connection.backlog() == 0) {
+        closeConnection(connection);
+        return;
+    }
+    updateReading(connection);
+}
+
+void BaseServer::updateReading(Connection& connection) {
+    // Pause above the limit, resume below half of it, so a slow reader
+    // does not toggle on every send. While a deferred reply is computed,
+    // whole requests waiting behind it also pause input; a partial request
+    // alone never keeps it paused.
+    const RequestStream& requests = connection.requests;
+    size_t backlog = connection.backlog();
+    bool change = connection.readPaused
+        ? !connection.busy && backlog <= MAX_OUTPUT_BACKLOG / 2
+        : backlog > MAX_OUTPUT_BACKLOG ||
+          (connection.busy && (requests.pending() > 0 || requests.buffered() > MAX_OUTPUT_BACKLOG));
+    if (!change || connection.closing) {
+        return;
+    }
+    connection.readPaused = !connection.readPaused;
+    if (connection.readPaused && backlog > MAX_OUTPUT_BACKLOG) {
+        log("Client " + std::to_string(connection.clientId) + " not reading replies, input paused");
+    }
+
+    if (backend == IoBackend::EPOLL) {
+        updateEpollInterest(connection);
+    } else if (connection.readPaused) {
+        // Single-shot receives are simply not re-armed
+        if (connection.recvArmed && ring->multishotRecv) {
+            submitRecvCancel(connection);
+        }
+    } else if (!connection.recvArmed) {
+        submitRecv(connection);
+    }
+}
+
+void BaseServer::closeConnection(Connection& connection) {
+    if (connection.closing) {
+        return;
+    }
+    connection.closing = true;
+    log("Client " + std::to_string(connection.clientId) + " disconnected");
+
+    if (backend == IoBackend::IO_URING) {
+        // Completes the armed recv (and any send) so their buffers can be released
+        shutdown(connection.clientSocket, SHUT_RDWR);
+        ioSyscalls++;
+    }
+}
+
+void BaseServer::deferReply(std::function<std::string()> work) {
+    deferredWork = std::move(work);
+}
+
+void BaseServer::startDeferred(Connection& connection) {
+    connection.busy = true;
+    int clientId = connection.clientId;
+    std::function<std::string()> work = std::move(deferredWork);
+    deferredWork = nullptr;
+
+    jobs.run([this, clientId, work]() {
+        DeferredReply reply{clientId, std::string(), false};
+        try {
+            reply.text = work();
+        } catch (const std::exception& e) {
+            reply.text = e.what();
+            reply.failed = true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            readyReplies.push_back(std::move(reply));
+        }
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeupFd, &one, sizeof(one));
+        (void)ignored;
+    });
+}
+
+void BaseServer::deliverReplies() {
+    uint64_t count;
+    ssize_t ignored = read(wakeupFd, &count, sizeof(count));
+    (void)ignored;
+    ioSyscalls++;
+
+    std::vector<DeferredReply> ready;
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        ready.swap(readyReplies);
+    }
+
+    // Replies for clients that have gone away are dropped
+    for (auto& reply : ready) {
+        auto it = connections.find(reply.clientId);
+        if (it == connections.end()) {
+            continue;
+        }
+        Connection& connection = *it->second;
+        connection.busy = false;
+        if (reply.failed) {
+            log("Client " + std::to_string(reply.clientId) + " error: " + reply.text);
+            connection.closeAfterFlush = true;
+            flush(connection);
+        } else {
+            connection.outputBuffer += reply.text;
+            processRequests(connection);
+        }
+        if (connection.closing && (backend == IoBackend::EPOLL || connection.pendingOps == 0)) {
+            releaseConnection(reply.clientId);
+        }
+    }
+}
+
+void BaseServer::releaseConnection(int clientId) {
+    auto it = connections.find(clientId);
+    if (it == connections.end()) {
+        return;
+    }
+    close(it->second->clientSocket);    // also removes it from the epoll set
+    ioSyscalls++;
+    connections.erase(it);
+    connectionCount--;
+}
+
+void BaseServer::closeAll() {
+    std::vector<int> ids;
+    for (auto& entry : connections) {
+        ids.push_back(entry.first);
+    }
+    for (int id : ids) {
+        Connection& connection = *connections[id];
+        if (!connection.closing) {
+            connection.closing = true;
+            shutdown(connection.clientSocket, SHUT_RDWR);
+        }
+        if (connection.pendingOps == 0) {
+            releaseConnection(id);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// io_uring backend
+// ---------------------------------------------------------------------------
+
+void BaseServer::runIoUringLoop() {
+    submitAccept();
+    submitWakeupPoll();
+
+    while (running) {
+        int result = ring->enter(1);
+        ioSyscalls++;
+        if (result < 0 && errno != EINTR && errno != EBUSY && errno != EAGAIN) {
+            log("io_uring_enter failed: " + errorString(errno));
+            break;
+        }
+        processCompletions();
+    }
+
+    // Shut every socket down and drain until the kernel holds no connection buffers
+    closeAll();
+    while (!connections.empty()) {
+        if (ring->enter(1) < 0 && errno != EINTR && errno != EBUSY && errno != EAGAIN) {
+            break;
+        }
+        ioSyscalls++;
+        processCompletions();
+    }
+}
+
+void BaseServer::processCompletions() {
+    unsigned head = *ring->cqHead;
+    while (head != __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+        const io_uring_cqe& cqe = ring->cqes[head & ring->cqMask];
+        uint64_t userData = cqe.user_data;
+        int result = cqe.res;
+        uint32_t flags = cqe.flags;
+
+        head++;
+        __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+
+        handleCompletion(userData, result, flags);
+    }
+}
+
+void BaseServer::handleCompletion(uint64_t userData, int result, uint32_t flags) {
+    uint64_t kind = userData >> 56;
+    int clientId = static_cast<int>(userData & 0xffffffffu);
+    bool more = (flags & IORING_CQE_F_MORE) != 0;
+
+    if (kind == OP_WAKEUP) {
+        deliverReplies();
+        if (running) {
+            submitWakeupPoll();
+        }
+        return;
+    }
+    if (kind == OP_CANCEL) {
+        return;
+    }
+
+    if (kind == OP_ACCEPT) {
+        if (result >= 0) {
+            if (running) {
+                Connection* connection = openConnection(result);
+                submitRecv(*connection);
+                flush(*connection);
+            } else {
+                close(result);
+            }
+        } else if (result != -ECANCELED && running) {
+            log("Failed to accept client: " + errorString(-result));
+        }
+        if (!more && running) {
+            submitAccept();
+        }
+        return;
+    }
+
+    auto it = connections.find(clientId);
+    if (it == connections.end()) {
+        return;
+    }
+    Connection& connection = *it->second;
+
+    if (kind == OP_RECV) {
+        if (flags & IORING_CQE_F_BUFFER) {
+            uint16_t bufferId = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+            if (result > 0) {
+                onData(connection, ring->bufferData(bufferId), result);
+            }
+            ring->recycleBuffer(bufferId);
+        }
+        if (!more) {
+            connection.pendingOps--;
+            connection.recvArmed = false;
+        }
+
+        if (result == 0) {
+            closeConnection(connection);
+        } else if (result < 0) {
+            if (result == -ECANCELED && !connection.closing) {
+                // Paused for back-pressure; input may have resumed since
+                if (!connection.readPaused) {
+                    submitRecv(connection);
+                }
+            } else if (result == -EINVAL && ring->multishotRecv && !connection.closing) {
+                // Kernel predates multishot recv: fall back to one recv per completion
+                ring->multishotRecv = false;
+                log("Multishot recv unsupported, using single-shot receives");
+                submitRecv(connection);
+            } else if (result == -ENOBUFS && !connection.closing) {
+                if (!connection.readPaused) {
+                    submitRecv(connection);
+                }
+            } else {
+                closeConnection(connection);
+            }
+        } else if (!more && !connection.closing && !connection.readPaused) {
+            submitRecv(connection);
+        }
+    } else if (kind == OP_SEND) {
+        connection.pendingOps--;
+        if (result < 0) {
+            connection.sendBuffer.clear();
+            closeConnection(connection);
+        } else {
+            connection.sendOffset += result;
+            if (connection.sendOffset < connection.sendBuffer.size() && !connection.closing) {
+                submitSend(connection);
+            } else {
+                connection.sendBuffer.clear();
+                flush(connection);
+                processRequests(connection);
+            }
+        }
+    }
+
+    if (connection.closing && connection.pendingOps == 0) {
+        releaseConnection(clientId);
+    }
+}
+
+void BaseServer::submitAccept() {
+    io_uring_sqe* sqe = ring->acquireSqe(ioSyscalls);
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = serverSocket;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = makeTag(OP_ACCEPT, 0);
+}
+
+void BaseServer::submitRecv(Connection& connection) {
+    io_uring_sqe* sqe = ring->acquireSqe(ioSyscalls);
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = connection.clientSocket;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    if (ring->multishotRecv) {
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+    } else {
+        sqe->len = BUFFER_SIZE;
+    }
+    sqe->user_data = makeTag(OP_RECV, connection.clientId);
+    connection.pendingOps++;
+    connection.recvArmed = true;
+}
+
+void BaseServer::submitRecvCancel(Connection& connection) {
+    // Ends the multishot recv; its final completion carries -ECANCELED
+    io_uring_sqe* sqe = ring->acquireSqe(ioSyscalls);
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = makeTag(OP_RECV, connection.clientId);
+    sqe->user_data = makeTag(OP_CANCEL, connection.clientId);
+}
+
+void BaseServer::submitSend(Connection& connection) {
+    io_uring_sqe* sqe = ring->acquireSqe(ioSyscalls);
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = connection.clientSocket;
+    sqe->addr = reinterpret_cast<uint64_t>(connection.sendBuffer.data() + connection.sendOffset);
+    sqe->len = static_cast<uint32_t>(connection.sendBuffer.size() - connection.sendOffset);
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = makeTag(OP_SEND, connection.clientId);
+    connection.pendingOps++;
+}
+
+void BaseServer::submitWakeupPoll() {
+    io_uring_sqe* sqe = ring->acquireSqe(ioSyscalls);
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = wakeupFd;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = makeTag(OP_WAKEUP, 0);
+}
+
+// ---------------------------------------------------------------------------
+// epoll backend
+// ---------------------------------------------------------------------------
+
+void BaseServer::runEpollLoop() {
+    struct epoll_event events[EPOLL_BATCH];
+
+    while (running) {
+        int ready = epoll_wait(epollFd, events, EPOLL_BATCH, -1);
+        ioSyscalls++;
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            log("epoll_wait failed: " + errorString(errno));
+            break;
+        }
+
+        for (int i = 0; i < ready && running; ++i) {
+            uint64_t tag = events[i].data.u64;
+            uint64_t kind = tag >> 56;
+            if (kind == OP_WAKEUP) {
+                deliverReplies();
+                continue;
+            }
+            if (kind == OP_ACCEPT) {
+                acceptEpollClients();
+                continue;
+            }
+
+            int clientId = static_cast<int>(tag & 0xffffffffu);
+            auto it = connections.find(clientId);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& connection = *it->second;
+
+            if ((events[i].events & EPOLLOUT) && connection.writeBlocked) {
+                flush(connection);
+                processRequests(connection);
+            }
+            if (!connection.closing && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                if (!connection.readPaused) {
+                    readEpollClient(connection);
+                } else if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    closeConnection(connection);
+                }
+            }
+            if (connection.closing) {
+                releaseConnection(clientId);
+            }
+        }
+    }
+
+    closeAll();
+}
+
+void BaseServer::acceptEpollClients() {
+    while (running) {
+        int clientSocket = accept4(serverSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        ioSyscalls++;
+        if (clientSocket < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                log("Failed to accept client: " + errorString(errno));
+            }
+            return;
+        }
+
+        Connection* connection = openConnection(clientSocket);
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = makeTag(OP_RECV, connection->clientId);
+        ioSyscalls++;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientSocket, &event) < 0) {
+            log("Failed to register client " + std::to_string(connection->clientId));
+            releaseConnection(connection->clientId);
+            continue;
+        }
+
+        flush(*connection);
+        if (connection->closing) {
+            releaseConnection(connection->clientId);
+        }
+    }
+}
+
+void BaseServer::readEpollClient(Connection& connection) {
+    // Level-triggered: one recv per readiness event, epoll reports leftovers again
+    char buffer[BUFFER_SIZE];
+    ssize_t bytesRead;
+    do {
+        bytesRead = recv(connection.clientSocket, buffer, sizeof(buffer), 0);
+        ioSyscalls++;
+    } while (bytesRead < 0 && errno == EINTR);
+
+    if (bytesRead > 0) {
+        onData(connection, buffer, bytesRead);
+    } else if (bytesRead == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        closeConnection(connection);
+    }
+}
+
+void BaseServer::updateEpollInterest(Connection& connection) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = connection.readPaused ? 0 : (EPOLLIN | EPOLLRDHUP);
+    if (connection.writeBlocked) {
+        event.events |= EPOLLOUT;
+    }
+    event.data.u64 = makeTag(OP_RECV, connection.clientId);
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.clientSocket, &event);
+    ioSyscalls++;
+}
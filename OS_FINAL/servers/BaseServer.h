@@ -0,0 +1,150 @@
+#ifndef BASE_SERVER_H
+#define BASE_SERVER_H
+
+#include "../common/RequestStream.h"
+#include "../threading/ThreadPool.h"
+#include <string>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+// Socket I/O backend used by the server event loop
+enum class IoBackend {
+    AUTO,       // io_uring when the kernel supports it, otherwise epoll
+    IO_URING,   // multishot accept/recv with a registered buffer ring
+    EPOLL       // non-blocking sockets with level-triggered epoll
+};
+
+// Newline-framed TCP server core shared by the single-threaded servers.
+// One event loop thread owns every socket; derived classes only supply the
+// welcome text and a reply for each request. Requests are taken off each
+// connection by a RequestStream: text lines, graph lines parsed while they
+// arrive (when the server opts in) and binary frames, mixed freely.
+// Handlers run on the event loop thread, so they should stay short; slow
+// work goes through deferReply(). A client stops being read while it has
+// more than MAX_OUTPUT_BACKLOG bytes of unsent replies (until half of that is
+// left) or has requests waiting behind a deferred reply.
+// Derived classes must call stop() in their own destructor.
+class BaseServer {
+public:
+    BaseServer(int port, const std::string& serverName, IoBackend backend = IoBackend::AUTO);
+    virtual ~BaseServer();
+
+    void start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Backend actually in use (resolved by start() when AUTO was requested)
+    IoBackend getBackend() const { return backend; }
+
+    // Number of I/O system calls made by the event loop so far
+    unsigned long long getIoSyscallCount() const { return ioSyscalls; }
+
+    static std::string backendToString(IoBackend backend);
+    static IoBackend stringToBackend(const std::string& name);
+
+protected:
+    // Text sent to a client as soon as it connects
+    virtual std::string welcomeMessage(int clientId) = 0;
+
+    // Reply to one request line ('\r' and '\n' stripped).
+    // Set closeAfterReply to disconnect the client once the reply is sent.
+    virtual std::string handleLine(int clientId, const std::string& line, bool& closeAfterReply) = 0;
+
+    // Graph line syntax parsed incrementally; NONE sends every line to handleLine()
+    virtual RequestStream::GraphLines graphLines() const { return RequestStream::GraphLines::NONE; }
+
+    // Reply to one graph line (only called when graphLines() is not NONE)
+    virtual std::string handleGraph(int clientId, const StreamMessage& request, bool& closeAfterReply);
+
+    // Reply to one binary request frame; the default rejects it with an
+    // error response frame
+    virtual std::string handleFrame(int clientId, const StreamMessage& request, bool& closeAfterReply);
+
+    // Called on the starting thread once the backend is chosen
+    virtual void onStart() {}
+
+    // Called from a handler: the reply is work()'s result instead of the
+    // handler's, computed on ThreadPool::shared() while the loop serves other
+    // clients. The client's later requests wait for it. If work() throws,
+    // the client is disconnected.
+    void deferReply(std::function<std::string()> work);
+
+    size_t getConnectionCount() const { return connectionCount; }
+    void log(const std::string& message);
+
+    static const size_t MAX_OUTPUT_BACKLOG = 1 << 20;
+
+private:
+    struct Connection;
+    struct IoUring;
+
+    int port;
+    std::string serverName;
+    IoBackend backend;
+    std::atomic<bool> running;
+    int serverSocket;
+    int wakeupFd;                // eventfd written by stop() and by deferred replies
+    std::thread loopThread;
+    std::mutex logMutex;
+    int clientCounter;
+
+    // Deferred replies: jobs run on the shared pool and hand their result
+    // back to the loop through readyReplies and wakeupFd
+    struct DeferredReply {
+        int clientId;
+        std::string text;
+        bool failed;
+    };
+    std::function<std::string()> deferredWork;   // set by deferReply() during a handler
+    TaskGroup jobs;
+    std::mutex readyMutex;
+    std::vector<DeferredReply> readyReplies;
+
+    // Loop-thread state
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;   // by client id
+    std::atomic<size_t> connectionCount;
+    std::atomic<unsigned long long> ioSyscalls;
+    int epollFd;
+    std::unique_ptr<IoUring> ring;
+
+    void setupSocket();
+    bool setupIoUring(std::string& reason);
+    void setupEpoll();
+
+    void runEpollLoop();
+    void runIoUringLoop();
+    void processCompletions();
+
+    // Shared connection handling
+    Connection* openConnection(int clientSocket);
+    void onData(Connection& connection, const char* data, size_t length);
+    void processRequests(Connection& connection);
+    void flush(Connection& connection);
+    void updateReading(Connection& connection);
+    void closeConnection(Connection& connection);
+    void releaseConnection(int clientId);
+    void closeAll();
+    void startDeferred(Connection& connection);
+    void deliverReplies();
+
+    // io_uring submissions
+    void submitAccept();
+    void submitRecv(Connection& connection);
+    void submitSend(Connection& connection);
+    void submitRecvCancel(Connection& connection);
+    void submitWakeupPoll();
+    void handleCompletion(uint64_t userData, int result, uint32_t flags);
+
+    // epoll helpers
+    void acceptEpollClients();
+    void readEpollClient(Connection& connection);
+    void updateEpollInterest(Connection& connection);
+};
+
+#endif
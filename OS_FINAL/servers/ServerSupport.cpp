@@ -0,0 +1,126 @@
+#include "ServerSupport.h"
+#include "../algorithms/AlgorithmFactory.h"
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <cerrno>
+#include <cstring>
+
+int ServerSupport::openListeningSocket(int port) {
+    // Allow as many connections as the hard descriptor limit permits
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    int serverSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (serverSocket < 0) {
+        throw std::runtime_error("Failed to create socket");
+    }
+
+    int opt = 1;
+    if (setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
+        close(serverSocket);
+        throw std::runtime_error("Failed to set socket options");
+    }
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+
+    if (bind(serverSocket, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        close(serverSocket);
+        throw std::runtime_error("Failed to bind to port " + std::to_string(port));
+    }
+
+    if (listen(serverSocket, SOMAXCONN) < 0) {
+        close(serverSocket);
+        throw std::runtime_error("Failed to listen on socket");
+    }
+    return serverSocket;
+}
+
+void ServerSupport::buildGraphs(int vertices, const std::vector<EdgeToken>& edges,
+                                std::unique_ptr<Graph>& undirectedGraph, std::unique_ptr<Graph>& directedGraph) {
+    if (vertices <= 0 || vertices > 50) {
+        throw std::invalid_argument("Vertices must be 1-50");
+    }
+
+    undirectedGraph = std::make_unique<Graph>(vertices, false);
+    directedGraph = std::make_unique<Graph>(vertices, true);
+    for (const auto& edge : edges) {
+        if (edge.u < 0 || edge.u >= vertices || edge.v < 0 || edge.v >= vertices || edge.u == edge.v) {
+            throw std::invalid_argument("Invalid edge: " + edgeTokenToString(edge));
+        }
+        undirectedGraph->addEdge(edge.u, edge.v, edge.weight);
+        directedGraph->addEdge(edge.u, edge.v, edge.weight);
+    }
+
+    // Algorithms only read the graphs from here on
+    undirectedGraph->freeze();
+    directedGraph->freeze();
+}
+
+std::string ServerSupport::formatAnalysis(const std::vector<AlgorithmResult>& results, int clientId,
+                                          long long totalMillis, int threadTag) {
+    std::ostringstream response;
+
+    response << "\n=== MULTI-ALGORITHM ANALYSIS ===\n";
+    response << "Client: " << clientId << "\n";
+    if (threadTag >= 0) {
+        response << "Thread: " << threadTag << "\n";
+    }
+    response << "Algorithms executed: " << results.size() << "\n";
+    response << "Total time: " << totalMillis << "ms\n";
+    response << "\n";
+
+    for (const auto& result : results) {
+        response << "• " << AlgorithmFactory::typeToString(result.type) << ": ";
+        if (result.success) {
+            response << result.result;
+            if (!result.executionTime.empty()) {
+                response << " (" << result.executionTime << ")";
+            }
+        } else {
+            response << "ERROR - " << result.error;
+        }
+        response << "\n";
+    }
+
+    response << "===============================";
+    return response.str();
+}
+
+std::string ServerSupport::formatError(const std::string& error, int clientId) {
+    std::ostringstream response;
+    response << "\n=== ERROR ===\n";
+    if (clientId >= 0) {
+        response << "Client: " << clientId << "\n";
+    }
+    response << "Error: " << error << "\n";
+    response << "=============";
+    return response.str();
+}
+
+bool ServerSupport::sendPending(int fd, std::string& output) {
+    size_t sent = 0;
+    bool ok = true;
+    while (sent < output.size()) {
+        ssize_t n = send(fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        ok = (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+        break;
+    }
+    output.erase(0, sent);
+    return ok;
+}
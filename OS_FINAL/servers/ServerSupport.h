@@ -0,0 +1,34 @@
+#ifndef SERVER_SUPPORT_H
+#define SERVER_SUPPORT_H
+
+#include "../common/Graph.h"
+#include "../common/EdgeToken.h"
+#include "../algorithms/AlgorithmStrategy.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+// Pieces shared by the multi-algorithm servers (Leader-Follower and
+// pipeline), so their sockets, graph checks and reply texts cannot drift apart.
+class ServerSupport {
+public:
+    // Non-blocking listening socket on every interface, after raising the
+    // descriptor limit as far as the hard limit allows. Throws std::runtime_error.
+    static int openListeningSocket(int port);
+
+    // Undirected graph for most algorithms, directed version for SCC, both
+    // frozen. Throws std::invalid_argument for a bad vertex count or edge.
+    static void buildGraphs(int vertices, const std::vector<EdgeToken>& edges,
+                            std::unique_ptr<Graph>& undirectedGraph, std::unique_ptr<Graph>& directedGraph);
+
+    // A threadTag of -1 leaves out the "Thread:" line
+    static std::string formatAnalysis(const std::vector<AlgorithmResult>& results, int clientId,
+                                      long long totalMillis, int threadTag = -1);
+    static std::string formatError(const std::string& error, int clientId = -1);
+
+    // Writes as much of 'output' as the non-blocking socket takes right now
+    // and erases it from the front. False once the socket is broken.
+    static bool sendPending(int fd, std::string& output);
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "ActiveObject.h"
+
+ActiveObject::ActiveObject(const std::string& name, size_t queueCapacity)
+    : name(name), queue(queueCapacity), running(false), maxQueueDepth(0), processed(0), failed(0),
+      totalWaitMicros(0), totalServiceMicros(0), maxWaitMicros(0) {}
+
+ActiveObject::~ActiveObject() {
+    stop();
+}
+
+void ActiveObject::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    thread = std::thread(&ActiveObject::run, this);
+}
+
+void ActiveObject::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    // The thread drains what is left once it sees the queue closed
+    queue.close();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool ActiveObject::enqueue(Work work) {
+    if (!queue.push(Item{std::move(work), std::chrono::steady_clock::now()})) {
+        return false;
+    }
+    recordDepth();
+    return true;
+}
+
+bool ActiveObject::tryEnqueue(Work work) {
+    if (!queue.tryPush(Item{std::move(work), std::chrono::steady_clock::now()})) {
+        return false;
+    }
+    recordDepth();
+    return true;
+}
+
+void ActiveObject::recordDepth() {
+    size_t depth = queue.sizeApprox();
+    size_t seen = maxQueueDepth.load(std::memory_order_relaxed);
+    while (depth > seen && !maxQueueDepth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+    }
+}
+
+void ActiveObject::run() {
+    Item item;
+    while (queue.pop(item)) {
+        auto begin = std::chrono::steady_clock::now();
+        unsigned long long waited =
+            std::chrono::duration_cast<std::chrono::microseconds>(begin - item.enqueued).count();
+
+        try {
+            item.work();
+        } catch (...) {
+            // Work items report their own errors; keep the thread alive
+            failed++;
+        }
+        item.work = nullptr;
+
+        auto end = std::chrono::steady_clock::now();
+        totalWaitMicros += waited;
+        totalServiceMicros += std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+        unsigned long long longest = maxWaitMicros.load(std::memory_order_relaxed);
+        while (waited > longest && !maxWaitMicros.compare_exchange_weak(longest, waited, std::memory_order_relaxed)) {
+        }
+        processed++;
+    }
+}
+
+ActiveObjectStats ActiveObject::getStats() const {
+    ActiveObjectStats stats;
+    stats.name = name;
+    stats.queueDepth = queue.sizeApprox();
+    stats.maxQueueDepth = maxQueueDepth.load();
+    stats.queueCapacity = queue.capacity();
+    stats.processed = processed.load();
+    stats.failed = failed.load();
+    stats.averageWaitMicros = stats.processed > 0 ? static_cast<double>(totalWaitMicros.load()) / stats.processed : 0.0;
+    stats.averageServiceMicros = stats.processed > 0 ? static_cast<double>(totalServiceMicros.load()) / stats.processed : 0.0;
+    stats.maxWaitMicros = static_cast<double>(maxWaitMicros.load());
+    return stats;
+}
@@ -0,0 +1,79 @@
+#ifndef ACTIVE_OBJECT_H
+#define ACTIVE_OBJECT_H
+
+#include "MPMCQueue.h"
+#include <string>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// Snapshot of an ActiveObject's queue and timing counters
+struct ActiveObjectStats {
+    std::string name;
+    size_t queueDepth;              // items waiting right now
+    size_t maxQueueDepth;           // high-water mark since start
+    size_t queueCapacity;
+    unsigned long long processed;
+    unsigned long long failed;      // work items that threw
+    double averageWaitMicros;       // enqueue -> start of run
+    double averageServiceMicros;    // run time
+    double maxWaitMicros;
+};
+
+// Active Object: a private thread that runs queued work items one at a time,
+// in FIFO order, decoupling the caller from the execution.
+// The queue is bounded: enqueue() blocks while it is full, so a slow object
+// pushes back on whoever feeds it instead of buffering without limit.
+class ActiveObject {
+public:
+    using Work = std::function<void()>;
+
+    explicit ActiveObject(const std::string& name, size_t queueCapacity = 256);
+
+    // Calls stop()
+    ~ActiveObject();
+
+    ActiveObject(const ActiveObject&) = delete;
+    ActiveObject& operator=(const ActiveObject&) = delete;
+
+    void start();
+
+    // Rejects new work, runs everything already queued, then joins the thread
+    void stop();
+
+    bool isRunning() const { return running; }
+
+    // False if the object was stopped before the work could be queued
+    bool enqueue(Work work);
+
+    // Non-blocking variant: also false when the queue is full
+    bool tryEnqueue(Work work);
+
+    const std::string& getName() const { return name; }
+    ActiveObjectStats getStats() const;
+
+private:
+    struct Item {
+        Work work;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    std::string name;
+    BlockingMPMCQueue<Item> queue;
+    std::thread thread;
+    std::atomic<bool> running;
+
+    // Statistics (microseconds)
+    std::atomic<size_t> maxQueueDepth;
+    std::atomic<unsigned long long> processed;
+    std::atomic<unsigned long long> failed;
+    std::atomic<unsigned long long> totalWaitMicros;
+    std::atomic<unsigned long long> totalServiceMicros;
+    std::atomic<unsigned long long> maxWaitMicros;
+
+    void run();
+    void recordDepth();
+};
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Bounded lock-free multi-producer/multi-consumer ring (Vyukov).
+// Each cell carries a sequence number that tells producers and consumers
+// whose turn it is, so a push or pop is one CAS on the shared position plus
+// one release store on the cell - no locks, no per-item allocation.
+// Values are stored in place; T must be default-constructible and movable.
+template <typename T>
+class MPMCQueue {
+public:
+    // Capacity is rounded up to a power of two (at least 2)
+    explicit MPMCQueue(size_t requestedCapacity) {
+        if (requestedCapacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        size_t capacity = 2;
+        while (capacity < requestedCapacity) capacity <<= 1;
+
+        cells = std::vector<Cell>(capacity);
+        mask = capacity - 1;
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePos.store(0, std::memory_order_relaxed);
+        dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    // False when the queue is full; value is left untouched in that case
+    bool tryPush(T& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(T&& value) {
+        return tryPush(value);
+    }
+
+    // False when the queue is empty
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->value = T();      // drop the moved-from handle now, not on reuse
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Snapshot only; may be stale by the time it is used
+    size_t sizeApprox() const {
+        size_t tail = enqueuePos.load(std::memory_order_relaxed);
+        size_t head = dequeuePos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static const size_t CACHE_LINE = 64;
+
+    std::vector<Cell> cells;
+    size_t mask;
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePos;
+};
+
+// Futex-backed event count for parking idle threads.
+// Waiters take a key, re-check their condition, then sleep only if nobody
+// notified since the key was taken. Notifiers skip the syscall while no
+// thread is registered, and notifyOne() issues at most one wake until a
+// woken thread runs; that thread must call notifyOne() again if work
+// remains (wake chaining), which BlockingMPMCQueue does.
+class EventCount {
+public:
+    EventCount() : epoch(0), waiters(0), wakePending(false) {}
+
+    uint32_t prepareWait() {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        return epoch.load(std::memory_order_seq_cst);
+    }
+
+    void cancelWait(uint32_t key) {
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+        if (epoch.load(std::memory_order_acquire) != key) {
+            wakePending.exchange(false, std::memory_order_acq_rel);
+        }
+    }
+
+    void wait(uint32_t key) {
+        while (epoch.load(std::memory_order_acquire) == key) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch), FUTEX_WAIT_PRIVATE, key,
+                    nullptr, nullptr, 0);
+        }
+        wakePending.exchange(false, std::memory_order_acq_rel);
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    bool hasWaiters() const {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return waiters.load(std::memory_order_seq_cst) > 0;
+    }
+
+    void notifyOne() {
+        if (!hasWaiters()) return;
+        if (wakePending.exchange(true, std::memory_order_acq_rel)) return;
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        long woken = syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch), FUTEX_WAKE_PRIVATE, 1,
+                             nullptr, nullptr, 0);
+        // Nobody was asleep (registered waiters see the new epoch and stay
+        // awake), so no thread will consume the flag: clear it here or every
+        // later notifyOne() would be skipped
+        if (woken <= 0) wakePending.store(false, std::memory_order_release);
+    }
+
+    void notifyAll() {
+        if (!hasWaiters()) return;
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch), FUTEX_WAKE_PRIVATE, INT_MAX,
+                nullptr, nullptr, 0);
+    }
+
+private:
+    std::atomic<uint32_t> epoch;
+    std::atomic<uint32_t> waiters;
+    std::atomic<bool> wakePending;   // a notifyOne wake has not been consumed yet
+};
+
+// MPMCQueue with blocking push/pop: threads spin briefly, then park on a
+// futex until the other side makes progress. close() wakes everyone and
+// rejects further pushes; pop() drains what is left and then returns false.
+// Stop producers before close() if every queued item must be consumed.
+template <typename T>
+class BlockingMPMCQueue {
+public:
+    explicit BlockingMPMCQueue(size_t capacity) : queue(capacity), closed(false) {}
+
+    // False if the queue was closed before the value could be queued
+    bool push(T value) {
+        bool parked = false;
+        for (int spin = 0; ; ++spin) {
+            if (closed.load(std::memory_order_acquire)) return false;
+            if (queue.tryPush(value)) {
+                pushed(parked);
+                return true;
+            }
+            if (spin < SPIN_LIMIT) continue;
+
+            uint32_t key = notFull.prepareWait();
+            if (closed.load(std::memory_order_acquire)) {
+                notFull.cancelWait(key);
+                return false;
+            }
+            if (queue.tryPush(value)) {
+                notFull.cancelWait(key);
+                pushed(true);
+                return true;
+            }
+            notFull.wait(key);
+            parked = true;
+        }
+    }
+
+    bool tryPush(T value) {
+        if (closed.load(std::memory_order_acquire) || !queue.tryPush(value)) return false;
+        pushed(false);
+        return true;
+    }
+
+    // False once the queue is closed and drained
+    bool pop(T& value) {
+        bool parked = false;
+        for (int spin = 0; ; ++spin) {
+            if (queue.tryPop(value)) {
+                popped(parked);
+                return true;
+            }
+            if (closed.load(std::memory_order_acquire)) {
+                return tryPop(value);
+            }
+            if (spin < SPIN_LIMIT) continue;
+
+            uint32_t key = notEmpty.prepareWait();
+            if (queue.tryPop(value)) {
+                notEmpty.cancelWait(key);
+                popped(true);
+                return true;
+            }
+            if (closed.load(std::memory_order_acquire)) {
+                notEmpty.cancelWait(key);
+                return tryPop(value);
+            }
+            notEmpty.wait(key);
+            parked = true;
+        }
+    }
+
+    bool tryPop(T& value) {
+        if (!queue.tryPop(value)) return false;
+        popped(false);
+        return true;
+    }
+
+    void close() {
+        closed.store(true, std::memory_order_release);
+        notEmpty.notifyAll();
+        notFull.notifyAll();
+    }
+
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+    size_t capacity() const { return queue.capacity(); }
+    size_t sizeApprox() const { return queue.sizeApprox(); }
+
+private:
+    static const int SPIN_LIMIT = 64;
+
+    // A thread that parked may have absorbed a wake meant for others:
+    // pass it on while the other side still has work.
+    void pushed(bool parked) {
+        notEmpty.notifyOne();
+        if (parked && queue.sizeApprox() < queue.capacity()) notFull.notifyOne();
+    }
+
+    void popped(bool parked) {
+        notFull.notifyOne();
+        if (parked && queue.sizeApprox() > 0) notEmpty.notifyOne();
+    }
+
+    MPMCQueue<T> queue;
+    std::atomic<bool> closed;
+    EventCount notEmpty;
+    EventCount notFull;
+};
+
+#endif
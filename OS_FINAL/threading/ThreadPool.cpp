@@ -0,0 +1,244 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+
+namespace {
+
+// Identifies the pool worker running on this thread (if any)
+thread_local ThreadPool* currentPool = nullptr;
+thread_local int currentWorker = -1;
+
+// Cheap per-thread random victim selection
+thread_local uint32_t stealSeed = 0;
+
+uint32_t nextRandom() {
+    if (stealSeed == 0) {
+        stealSeed = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+    }
+    stealSeed ^= stealSeed << 13;
+    stealSeed ^= stealSeed >> 17;
+    stealSeed ^= stealSeed << 5;
+    return stealSeed;
+}
+
+// Failed help attempts before a waiting thread starts blocking
+const int HELP_SPIN_LIMIT = 16;
+
+}
+
+// ---------------------------------------------------------------------------
+// WorkDeque
+
+ThreadPool::WorkDeque::WorkDeque() : top(0), bottom(0), array(new Array(INITIAL_CAPACITY)) {}
+
+ThreadPool::WorkDeque::~WorkDeque() {
+    // Leftover tasks are impossible: the pool drains before joining
+    delete array.load(std::memory_order_relaxed);
+}
+
+void ThreadPool::WorkDeque::push(Task* task) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    Array* a = array.load(std::memory_order_relaxed);
+    if (b - t > a->capacity - 1) {
+        Array* grown = new Array(a->capacity * 2);
+        for (int64_t i = t; i < b; ++i) grown->put(i, a->get(i));
+        retired.emplace_back(a);
+        array.store(grown, std::memory_order_release);
+        a = grown;
+    }
+    a->put(b, task);
+    bottom.store(b + 1, std::memory_order_release);
+}
+
+ThreadPool::Task* ThreadPool::WorkDeque::take() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    Array* a = array.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_seq_cst);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Task* task = a->get(b);
+    if (t == b) {
+        // Last element: race the thieves for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+ThreadPool::Task* ThreadPool::WorkDeque::steal() {
+    while (true) {
+        int64_t t = top.load(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_seq_cst);
+        if (t >= b) return nullptr;
+
+        Array* a = array.load(std::memory_order_acquire);
+        Task* task = a->get(t);
+        if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return task;
+        }
+        // Lost to the owner or another thief; the deque may still hold work
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ThreadPool
+
+ThreadPool::ThreadPool(size_t threads, bool pinThreads)
+    : injection(INJECTION_CAPACITY), stopping(false), steals(0) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<int> cpus;
+    if (pinThreads) {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+            }
+        }
+    }
+
+    // Every deque must exist before any worker starts stealing
+    for (size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, static_cast<int>(i), cpu);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stopping.store(true, std::memory_order_seq_cst);
+    idle.notifyAll();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return currentPool == this;
+}
+
+void ThreadPool::schedule(Task* task) {
+    if (currentPool == this) {
+        workers[currentWorker]->deque.push(task);
+    } else {
+        // Full injection queue: the caller helps drain it instead of blocking
+        while (!injection.tryPush(task)) {
+            if (!runPendingTask()) std::this_thread::yield();
+        }
+    }
+    idle.notifyOne();
+}
+
+ThreadPool::Task* ThreadPool::findTask(int self) {
+    Task* task = nullptr;
+    if (self >= 0 && (task = workers[self]->deque.take()) != nullptr) return task;
+    if (injection.tryPop(task)) return task;
+
+    size_t count = workers.size();
+    size_t start = nextRandom() % count;
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (static_cast<int>(victim) == self) continue;
+        if ((task = workers[victim]->deque.steal()) != nullptr) {
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::runTask(Task* task) {
+    std::unique_ptr<Task> owned(task);
+    owned->run();
+}
+
+bool ThreadPool::runPendingTask() {
+    Task* task = findTask(currentPool == this ? currentWorker : -1);
+    if (!task) return false;
+    runTask(task);
+    return true;
+}
+
+void ThreadPool::helpUntil(Completion& completion) {
+    int misses = 0;
+    while (!completion.isSet()) {
+        if (runPendingTask()) {
+            misses = 0;
+        } else if (++misses < HELP_SPIN_LIMIT) {
+            std::this_thread::yield();
+        } else if (isWorkerThread()) {
+            // Never block a worker for good: work it must run may show up
+            // in the queues while it waits (nested waits on each other)
+            completion.waitFor(std::chrono::microseconds(200));
+        } else {
+            completion.wait();
+        }
+    }
+    // Synchronize with set() so the caller may free the completion
+    completion.wait();
+}
+
+void ThreadPool::workerLoop(int index, int cpu) {
+    currentPool = this;
+    currentWorker = index;
+
+    if (cpu >= 0) {
+        // Best effort: a restricted cpuset just leaves the worker unpinned
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    bool woken = false;
+    while (true) {
+        Task* task = nullptr;
+        for (int round = 0; round < IDLE_SPIN_ROUNDS && !task; ++round) {
+            task = findTask(index);
+        }
+
+        if (!task) {
+            uint32_t key = idle.prepareWait();
+            task = findTask(index);
+            if (task) {
+                idle.cancelWait(key);
+                woken = true;   // may have absorbed a wake meant for another worker
+            } else if (stopping.load(std::memory_order_seq_cst)) {
+                idle.cancelWait(key);
+                break;
+            } else {
+                idle.wait(key);
+                woken = true;
+                continue;
+            }
+        }
+
+        // A parked worker that found work passes the wake on (see EventCount)
+        if (woken) {
+            idle.notifyOne();
+            woken = false;
+        }
+        runTask(task);
+    }
+
+    currentPool = nullptr;
+    currentWorker = -1;
+}
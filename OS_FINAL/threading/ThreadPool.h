@@ -0,0 +1,441 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "MPMCQueue.h"
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+class ThreadPool;
+
+// One-shot flag a thread can block on. set() publishes under the mutex, and
+// a waiter that saw the flag takes the mutex once more before returning, so
+// the owner may destroy the Completion as soon as wait() returns.
+class Completion {
+public:
+    Completion() : flag(false) {}
+
+    bool isSet() const { return flag.load(std::memory_order_acquire); }
+
+    void set() {
+        std::lock_guard<std::mutex> lock(mutex);
+        flag.store(true, std::memory_order_release);
+        cv.notify_all();
+    }
+
+    void reset() { flag.store(false, std::memory_order_relaxed); }
+
+    // True once set; false if the timeout expired first
+    bool waitFor(std::chrono::microseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, timeout, [this] { return isSet(); });
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return isSet(); });
+    }
+
+private:
+    std::atomic<bool> flag;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+// Shared state behind a TaskFuture
+struct FutureStateBase {
+    Completion done;
+    std::exception_ptr error;
+    std::mutex continuationMutex;
+    std::vector<std::function<void()>> continuations;
+
+    // Mark the result ready and schedule everything chained with then()
+    void finish() {
+        std::vector<std::function<void()>> ready;
+        {
+            std::lock_guard<std::mutex> lock(continuationMutex);
+            done.set();
+            ready.swap(continuations);
+        }
+        for (auto& continuation : ready) continuation();
+    }
+
+    void addContinuation(std::function<void()> continuation) {
+        {
+            std::lock_guard<std::mutex> lock(continuationMutex);
+            if (!done.isSet()) {
+                continuations.push_back(std::move(continuation));
+                return;
+            }
+        }
+        continuation();
+    }
+};
+
+template <typename T>
+struct FutureState : FutureStateBase {
+    std::optional<T> value;
+
+    template <typename F>
+    void fulfil(F& f) {
+        try {
+            value.emplace(f());
+        } catch (...) {
+            error = std::current_exception();
+        }
+        finish();
+    }
+};
+
+template <>
+struct FutureState<void> : FutureStateBase {
+    template <typename F>
+    void fulfil(F& f) {
+        try {
+            f();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        finish();
+    }
+};
+
+template <typename T>
+class TaskFuture;
+
+// Work-stealing thread pool.
+// Every worker owns a Chase-Lev deque: it pushes and pops its own tasks at
+// the bottom (LIFO, cache-warm) while idle workers steal from the top
+// (FIFO, oldest and usually largest). Tasks posted from outside the pool go
+// through a bounded lock-free injection queue. Idle workers spin through one
+// steal round and then park on a futex; posting wakes at most one of them.
+//
+// A thread waiting on pool work (TaskFuture::get, TaskGroup::wait,
+// parallelFor) runs queued tasks meanwhile instead of just blocking, so
+// nested parallelism cannot deadlock the pool.
+// Algorithms and servers should share ThreadPool::shared() rather than
+// starting their own threads, so the machine is never oversubscribed.
+class ThreadPool {
+public:
+    // threads == 0 means one worker per hardware thread.
+    // With pinThreads, worker i is bound to the i-th CPU the process may use.
+    explicit ThreadPool(size_t threads = 0, bool pinThreads = false);
+
+    // Runs every task already queued, then joins the workers.
+    // Tasks must not be posted from outside the pool once destruction begins.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool with one worker per hardware thread
+    static ThreadPool& shared();
+
+    size_t getThreadCount() const { return workers.size(); }
+
+    // True when called from one of this pool's workers
+    bool isWorkerThread() const;
+
+    // Fire-and-forget. An exception escaping f is swallowed so the worker
+    // survives; use submit() to observe failures.
+    template <typename F>
+    void post(F&& f) {
+        schedule(new FunctionTask<typename std::decay<F>::type>(std::forward<F>(f)));
+    }
+
+    // Run f on the pool; the future carries its result or exception
+    template <typename F>
+    TaskFuture<typename std::invoke_result<typename std::decay<F>::type&>::type> submit(F&& f);
+
+    // Calls body(lo, hi) over disjoint subranges of [begin, end) of at most
+    // grain elements. The calling thread takes part; returns when all are done
+    // and rethrows the first exception thrown by body.
+    template <typename F>
+    void parallelFor(size_t begin, size_t end, const F& body, size_t grain = 1);
+
+    // Run one queued task on the calling thread; false if none was found
+    bool runPendingTask();
+
+    // Help with queued tasks until the completion is set
+    void helpUntil(Completion& completion);
+
+    // Number of tasks taken from another worker's deque so far
+    unsigned long long getStealCount() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+    struct Task {
+        virtual ~Task() = default;
+        virtual void run() = 0;
+    };
+
+    template <typename F>
+    struct FunctionTask : Task {
+        F function;
+        explicit FunctionTask(F f) : function(std::move(f)) {}
+        void run() override {
+            try {
+                function();
+            } catch (...) {
+            }
+        }
+    };
+
+    // Chase-Lev work-stealing deque (Le et al., PPoPP 2013). Only the owner
+    // calls push/take; any thread may steal. Grown arrays are retired, not
+    // freed, because a thief may still be reading the old one.
+    class WorkDeque {
+    public:
+        WorkDeque();
+        ~WorkDeque();
+        void push(Task* task);
+        Task* take();
+        Task* steal();
+
+    private:
+        struct Array {
+            int64_t capacity;
+            std::unique_ptr<std::atomic<Task*>[]> slots;
+            explicit Array(int64_t capacity)
+                : capacity(capacity), slots(new std::atomic<Task*>[capacity]) {}
+            Task* get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+            void put(int64_t i, Task* task) { slots[i & (capacity - 1)].store(task, std::memory_order_relaxed); }
+        };
+
+        static const int64_t INITIAL_CAPACITY = 256;
+
+        alignas(64) std::atomic<int64_t> top;
+        alignas(64) std::atomic<int64_t> bottom;
+        std::atomic<Array*> array;
+        std::vector<std::unique_ptr<Array>> retired;   // owner-only
+    };
+
+    struct Worker {
+        WorkDeque deque;
+        std::thread thread;
+    };
+
+    static const size_t INJECTION_CAPACITY = 4096;
+    static const int IDLE_SPIN_ROUNDS = 2;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    MPMCQueue<Task*> injection;
+    EventCount idle;
+    std::atomic<bool> stopping;
+    std::atomic<unsigned long long> steals;
+
+    void schedule(Task* task);
+    Task* findTask(int self);
+    void runTask(Task* task);
+    void workerLoop(int index, int cpu);
+};
+
+// Result of ThreadPool::submit(). Copyable handle to a shared result;
+// get() may be called any number of times, from any thread.
+template <typename T>
+class TaskFuture {
+public:
+    TaskFuture() : pool(nullptr) {}
+
+    bool valid() const { return state != nullptr; }
+    bool isReady() const { return state->done.isSet(); }
+
+    void wait() const { pool->helpUntil(state->done); }
+
+    // Rethrows the task's exception, if it threw
+    const T& get() const {
+        wait();
+        if (state->error) std::rethrow_exception(state->error);
+        return *state->value;
+    }
+
+    // Schedule f(result) on the pool once this future is ready.
+    // An exception from this task skips f and carries over to the new future.
+    template <typename F>
+    TaskFuture<typename std::invoke_result<F&, const T&>::type> then(F f) const {
+        using U = typename std::invoke_result<F&, const T&>::type;
+        auto next = std::make_shared<FutureState<U>>();
+        auto source = state;
+        ThreadPool* target = pool;
+        state->addContinuation([target, source, next, f]() mutable {
+            target->post([source, next, f]() mutable {
+                if (source->error) {
+                    next->error = source->error;
+                    next->finish();
+                    return;
+                }
+                auto call = [&]() -> U { return f(*source->value); };
+                next->fulfil(call);
+            });
+        });
+        return TaskFuture<U>(target, next);
+    }
+
+private:
+    friend class ThreadPool;
+    template <typename> friend class TaskFuture;
+
+    TaskFuture(ThreadPool* pool, std::shared_ptr<FutureState<T>> state) : pool(pool), state(std::move(state)) {}
+
+    ThreadPool* pool;
+    std::shared_ptr<FutureState<T>> state;
+};
+
+template <>
+class TaskFuture<void> {
+public:
+    TaskFuture() : pool(nullptr) {}
+
+    bool valid() const { return state != nullptr; }
+    bool isReady() const { return state->done.isSet(); }
+
+    void wait() const { pool->helpUntil(state->done); }
+
+    void get() const {
+        wait();
+        if (state->error) std::rethrow_exception(state->error);
+    }
+
+    template <typename F>
+    TaskFuture<typename std::invoke_result<F&>::type> then(F f) const {
+        using U = typename std::invoke_result<F&>::type;
+        auto next = std::make_shared<FutureState<U>>();
+        auto source = state;
+        ThreadPool* target = pool;
+        state->addContinuation([target, source, next, f]() mutable {
+            target->post([source, next, f]() mutable {
+                if (source->error) {
+                    next->error = source->error;
+                    next->finish();
+                    return;
+                }
+                next->fulfil(f);
+            });
+        });
+        return TaskFuture<U>(target, next);
+    }
+
+private:
+    friend class ThreadPool;
+    template <typename> friend class TaskFuture;
+
+    TaskFuture(ThreadPool* pool, std::shared_ptr<FutureState<void>> state) : pool(pool), state(std::move(state)) {}
+
+    ThreadPool* pool;
+    std::shared_ptr<FutureState<void>> state;
+};
+
+// Fork-join scope: run() any number of tasks (also from inside them), then
+// wait() for all of them. wait() helps the pool and rethrows the first
+// exception a task threw. The destructor waits as well, since tasks refer
+// to the group.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool(pool), pending(0) {
+        done.set();
+    }
+
+    ~TaskGroup() {
+        settle();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename F>
+    void run(F&& f) {
+        if (pending.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            done.reset();
+        }
+        pool.post([this, f = std::forward<F>(f)]() mutable {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (!error) error = std::current_exception();
+            }
+            // A run() racing with the last completion re-checks under the lock
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (pending.load(std::memory_order_acquire) == 0) done.set();
+            }
+        });
+    }
+
+    void wait() {
+        settle();
+        std::exception_ptr failure;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            failure = error;
+            error = nullptr;
+        }
+        if (failure) std::rethrow_exception(failure);
+    }
+
+private:
+    // Returns once every task finished and none still touches the group
+    void settle() {
+        pool.helpUntil(done);
+        std::lock_guard<std::mutex> lock(stateMutex);
+    }
+
+    ThreadPool& pool;
+    std::atomic<int> pending;
+    Completion done;
+    std::mutex stateMutex;
+    std::exception_ptr error;
+};
+
+template <typename F>
+TaskFuture<typename std::invoke_result<typename std::decay<F>::type&>::type> ThreadPool::submit(F&& f) {
+    using T = typename std::invoke_result<typename std::decay<F>::type&>::type;
+    auto state = std::make_shared<FutureState<T>>();
+    post([state, f = std::forward<F>(f)]() mutable {
+        state->fulfil(f);
+    });
+    return TaskFuture<T>(this, state);
+}
+
+template <typename F>
+void ThreadPool::parallelFor(size_t begin, size_t end, const F& body, size_t grain) {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+    size_t chunks = (end - begin + grain - 1) / grain;
+
+    // Chunks are claimed from a shared counter, so helpers that start late
+    // simply find nothing left; at most one helper per worker is forked.
+    std::atomic<size_t> next{0};
+    auto drain = [&]() {
+        for (size_t chunk = next.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+             chunk = next.fetch_add(1, std::memory_order_relaxed)) {
+            size_t lo = begin + chunk * grain;
+            body(lo, lo + grain < end ? lo + grain : end);
+        }
+    };
+
+    TaskGroup group(*this);
+    size_t helpers = chunks - 1 < workers.size() ? chunks - 1 : workers.size();
+    for (size_t i = 0; i < helpers; ++i) group.run(drain);
+    try {
+        drain();
+    } catch (...) {
+        next.store(chunks, std::memory_order_relaxed);
+        group.wait();
+        throw;
+    }
+    group.wait();
+}
+
+#endif